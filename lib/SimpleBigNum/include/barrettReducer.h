@@ -0,0 +1,38 @@
+#pragma once
+#include "bigNum.h"
+
+namespace sbn
+{
+
+// Class divides numbers by a fixed divisor using Barrett reduction.
+// Reciprocal of the divisor is calculated once, so every division costs about two multiplications.
+// Short divisors are divided using long division, which is faster for them.
+class BarrettReducer
+{
+public:
+    // Ctor. Precomputes reciprocal of the divisor.
+    // [WARNING]: Divisor cannot be zero.
+    explicit BarrettReducer( const SimpleBigNum& divisor );
+
+    // Returns the divisor.
+    const SimpleBigNum& GetDivisor() const;
+
+    // Divides number by the divisor, storing quotient and remainder. Output numbers may be the same as the number.
+    void DivMod( const SimpleBigNum& number, SimpleBigNum& out_quotient, SimpleBigNum& out_remainder ) const;
+
+    // Divides number inplace by the divisor.
+    void Divide( SimpleBigNum& number ) const;
+
+    // Replaces number inplace with the remainder of division by the divisor.
+    void Mod( SimpleBigNum& number ) const;
+
+private:
+    // Divides number less then B^(2n), where n is the number of limbs of the divisor.
+    void DivModStep( const SimpleBigNum& number, SimpleBigNum& out_quotient, SimpleBigNum& out_remainder ) const;
+
+    SimpleBigNum m_divisor;
+    // floor( B^(2n) / divisor ), zero for short divisors.
+    SimpleBigNum m_reciprocal;
+};
+
+}
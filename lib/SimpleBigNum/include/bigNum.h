@@ -2,10 +2,23 @@
 #include <cstdint>
 #include <vector>
 #include <string>
+#include "../src/tools/dynamicBuffer/dynamicBuffer.h"
 
 namespace sbn
 {
 
+class BarrettReducer;
+class FixedBaseExponentiator;
+class MontgomeryContext;
+
+namespace internal
+{
+class DecimalConverter;
+class GcdCalculator;
+class ModularMultiplier;
+class RadixConverter;
+}
+
 // Class represent number of arbitrary size.
 class SimpleBigNum
 {
@@ -19,10 +32,16 @@ public:
     // Ctor. Initilalizes big num from given number.
     SimpleBigNum( uint64_t number );
 
-    // Ctor. Initilalizes big num from given raw number. This just copies given digits into internal structures.
+    // Ctor. Initilalizes big num from given raw number. Given digits are packed into internal limbs.
     // The number has to be expressed as number base 256 and stored in little endian format.
     SimpleBigNum( TRawNumberDigits::const_iterator digitsBegin, TRawNumberDigits::const_iterator digitsEnd );
 
+    // Move ctor. Leaves other number equal to 0, so it still has at least one limb.
+    SimpleBigNum( SimpleBigNum&& other );
+
+    // Copy ctor.
+    SimpleBigNum( const SimpleBigNum& other ) = default;
+
     // Adds inplace other number.
     void Add( const SimpleBigNum& other );
 
@@ -31,12 +50,68 @@ public:
     // when other number is smaller then this number. In the cases where other number is bigger then this one, this number will be set to zero.
     void Subtruct( const SimpleBigNum& other );
 
-    // Multiplies inplace by other number.
+    // Multiplies inplace by other number. Multiplication by itself is done as squaring.
     void Multiply( const SimpleBigNum& other );
 
+    // Squares inplace. Costs about 2/3 of general multiplication.
+    void Square();
+
+    // Raises inplace to the power of exponent. Zero to the power of zero is one.
+    // Powers of two ( including powers of 256 ) are computed as shifts.
+    // [WARNING]: Number is set to zero, if power of two factor of the result does not fit into 2^32 limbs.
+    void Pow( uint64_t exponent );
+
+    // Replaces number inplace with its integer square root ( rounded down ).
+    void Sqrt();
+
+    // Replaces number inplace with its integer square root and stores number - root^2 in out_remainder, which cannot be this number.
+    void SqrtRem( SimpleBigNum& out_remainder );
+
+    // Replaces number inplace with its integer n-th root ( rounded down ).
+    // [WARNING]: Zeroth root is zero.
+    void Root( uint32_t n );
+
     // Divides inplace by other number.
     void Divide( const SimpleBigNum& other );
 
+    // Divides by other number, storing quotient and remainder in one pass. Output numbers may be the same as the other number.
+    // [WARNING]: Division by zero gives zero quotient and zero remainder.
+    void DivMod( const SimpleBigNum& other, SimpleBigNum& out_quotient, SimpleBigNum& out_remainder ) const;
+
+    // Replaces number inplace with the remainder of division by other number.
+    // [WARNING]: Remainder of division by zero is zero.
+    void Mod( const SimpleBigNum& other );
+
+    // Raises inplace to the power of exponent modulo modulus using sliding window exponentiation.
+    // Odd moduli use Montgomery multiplication, even ones Barrett reduction.
+    // [WARNING]: Any number modulo zero is zero.
+    void PowMod( const SimpleBigNum& exponent, const SimpleBigNum& modulus );
+
+    // Replaces number inplace with the greatest common divisor of this and other number. Gcd with zero is the other number.
+    void Gcd( const SimpleBigNum& other );
+
+    // Replaces number inplace with the greatest common divisor of this and other number and stores coefficients
+    // 1 <= x <= other / gcd and y < this / gcd, such that this * x - other * y = gcd.
+    // [WARNING]: If other number is zero, x is one and y is zero. If this number is zero, there are no such coefficients
+    // and both are set to zero.
+    void ExtendedGcd( const SimpleBigNum& other, SimpleBigNum& out_x, SimpleBigNum& out_y );
+
+    // Replaces number inplace with its inverse modulo modulus. Returns false and sets number to zero, if the inverse does not exist.
+    bool ModInverse( const SimpleBigNum& modulus );
+
+    // Overloads for single digit operands. They work directly on limbs, without creating temporary SimpleBigNum.
+    void Add( uint64_t other );
+    void Subtruct( uint64_t other );
+    void Multiply( uint64_t other );
+    void Divide( uint64_t other );
+
+    // Divides inplace by other number and returns the remainder.
+    // [WARNING]: Division by zero sets number to zero and returns zero.
+    uint64_t DivMod( uint64_t other );
+
+    // Replaces number inplace with the remainder of division by other number.
+    void Mod( uint64_t other );
+
     // Shifts left by value. Effectively works as multiplying number by 256^value.
     void ShitfLeft( uint32_t value );
 
@@ -58,6 +133,13 @@ public:
     // Returns true if other number is equal to current one.
     bool IsEqualTo( const SimpleBigNum& other ) const;
 
+    // Comparisons with single digit number.
+    bool IsGreaterThen( uint64_t other ) const;
+    bool IsLessThen( uint64_t other ) const;
+    bool IsGreaterOrEqualTo( uint64_t other ) const;
+    bool IsLessOrEqualTo( uint64_t other ) const;
+    bool IsEqualTo( uint64_t other ) const;
+
     // Returns if number is equal to zero.
     bool IsZero() const;
 
@@ -70,20 +152,40 @@ public:
     // Sets number to 1.
     void SetOne();
 
-    // Returns number of digits.
+    // Returns number of digits in base 256.
     uint32_t GetNumberOfDigits() const;
 
     // Stores number to string.
     std::string ToString( bool addSeparators = false ) const;
 
     // Initializes number from string numbers, that has to represent decimal number.
-    void FromString( const std::string& numberBase10 );
+    // Returns false and sets number to zero, if the string is empty or contains characters other then decimal digits.
+    bool FromString( const std::string& numberBase10 );
+
+    // Stores number to hexadecimal string with lowercase letters. Time complexity: O( n ).
+    std::string ToHexString() const;
+
+    // Initializes number from hexadecimal string. Both lowercase and uppercase letters are accepted. Time complexity: O( n ).
+    // Returns false and sets number to zero, if the string is empty or contains characters other then hexadecimal digits.
+    bool FromHexString( const std::string& numberBase16 );
+
+    // Stores number to string in given base, which has to be 2, 4, 8, 16 or 32. Time complexity: O( n ).
+    // [WARNING]: Returns empty string for other bases.
+    std::string ToPowerOfTwoBaseString( uint32_t base ) const;
+
+    // Initializes number from string in given base, which has to be 2, 4, 8, 16 or 32. Time complexity: O( n ).
+    // Returns false and sets number to zero, if the base is not supported, the string is empty or contains characters other then digits of the base.
+    bool FromPowerOfTwoBaseString( const std::string& number, uint32_t base );
 
     // --- operators ----------------
+    SimpleBigNum& operator=( const SimpleBigNum& other ) = default;
+    // Move assignment swaps limbs, so other number keeps valid ( previous ) value of this number.
+    SimpleBigNum& operator=( SimpleBigNum&& other ) = default;
     SimpleBigNum& operator+=( const SimpleBigNum& other );
     SimpleBigNum& operator-=( const SimpleBigNum& other );
     SimpleBigNum& operator*=( const SimpleBigNum& other );
     SimpleBigNum& operator/=( const SimpleBigNum& other );
+    SimpleBigNum& operator%=( const SimpleBigNum& other );
     SimpleBigNum& operator<<( uint32_t value );
     SimpleBigNum& operator>>( uint32_t value );
     bool operator>( const SimpleBigNum& other ) const;
@@ -92,23 +194,131 @@ public:
     bool operator>=( const SimpleBigNum& other ) const;
     bool operator==( const SimpleBigNum& other ) const;
     bool operator!=( const SimpleBigNum& other ) const;
+    SimpleBigNum& operator+=( uint64_t other );
+    SimpleBigNum& operator-=( uint64_t other );
+    SimpleBigNum& operator*=( uint64_t other );
+    SimpleBigNum& operator/=( uint64_t other );
+    SimpleBigNum& operator%=( uint64_t other );
+    bool operator>( uint64_t other ) const;
+    bool operator<( uint64_t other ) const;
+    bool operator<=( uint64_t other ) const;
+    bool operator>=( uint64_t other ) const;
+    bool operator==( uint64_t other ) const;
+    bool operator!=( uint64_t other ) const;
     // ------------------------------
 
 private:
+    // Reducers work directly on limbs of the numbers.
+    friend class BarrettReducer;
+    friend class FixedBaseExponentiator;
+    friend class MontgomeryContext;
+    friend class internal::DecimalConverter;
+    friend class internal::GcdCalculator;
+    friend class internal::ModularMultiplier;
+    friend class internal::RadixConverter;
+
+    // Limbs container. Limb is a single digit of the number expressed in base 2^64.
+    using TLimbs = tools::DynamicBuffer< uint64_t >;
+
+    // Ctor. Initializes big num from given range of limbs.
+    SimpleBigNum( const uint64_t* limbsBegin, const uint64_t* limbsEnd );
+
+    // Returns allocator used for limbs of all numbers.
+    static tools::IAllocator& GetAllocator();
+
+    // Initializes number from raw number base 256 stored in little endian format.
+    void AssignRawDigits( TRawNumberDigits::const_iterator digitsBegin, TRawNumberDigits::const_iterator digitsEnd );
+
+    // Returns number as raw number base 256 stored in little endian format.
+    TRawNumberDigits GetRawDigits() const;
+
+    // Returns number of limbs.
+    uint32_t GetNumberOfLimbs() const;
+
+    // Returns number of significant bits. Zero has no significant bits.
+    uint32_t GetNumberOfBits() const;
+
+    // Returns bitsCount ( at most 64 ) bits starting from bit bitIndex. Bits above the number are zeros.
+    uint64_t GetBits( uint32_t bitIndex, uint32_t bitsCount ) const;
+
+    // Shifts left by value. Effectively works as multiplying number by (2^64)^value.
+    void ShiftLeftLimbs( uint32_t value );
+
+    // Shifts right by value. Effectively works as dividing number by (2^64)^value.
+    void ShiftRightLimbs( uint32_t value );
+
+    // Shifts left by value bits.
+    void ShiftLeftBits( uint32_t value );
+
+    // Shifts right by value bits.
+    void ShiftRightBits( uint32_t value );
+
     // Removes leading zeros.
     void RemoveLeadingZeros();
 
+    // Splits number into numberOfParts parts of partSize limbs. The least significant part is stored first.
+    void SplitIntoParts( uint32_t partSize, uint32_t numberOfParts, SimpleBigNum* out_parts ) const;
+
+    // Selects multiplication method based on sizes of the numbers.
+    void MultiplyImpl( const SimpleBigNum& other );
+
     // Implementation of multiplication for small numbers.
     void MultiplyImpl_Basecase( const SimpleBigNum& other );
 
+    // Implementation of multiplication of numbers of very different sizes. Bigger number is multiplied chunk by chunk.
+    void MultiplyImpl_Unbalanced( const SimpleBigNum& other );
+
     // Implementation of multiplication using Karatsuba method.
     void MultiplyImpl_Karatsuba( const SimpleBigNum& other );
 
-    // Converts srcNumber with srcBase to new number with dstBase.
-    std::vector< uint8_t > ConvertNumber( const std::vector< uint8_t >& srcNumber, uint16_t srcBase, uint16_t dstBase ) const;
+    // Implementation of multiplication using Toom-3 method. Squares the number if other is this number.
+    void MultiplyImpl_Toom3( const SimpleBigNum& other );
+
+    // Implementation of multiplication using Toom-4 method. Squares the number if other is this number.
+    void MultiplyImpl_Toom4( const SimpleBigNum& other );
+
+    // Implementation of multiplication using number theoretic transform. Squares the number if other is this number.
+    void MultiplyImpl_Ntt( const SimpleBigNum& other );
+
+    // Selects squaring method based on size of the number.
+    void SquareImpl();
+
+    // Implementation of squaring for small numbers.
+    void SquareImpl_Basecase();
+
+    // Implementation of squaring using Karatsuba method.
+    void SquareImpl_Karatsuba();
+
+    // Implementation of raising to the power using left-to-right binary exponentiation.
+    // Exponent has to be greater then one.
+    void PowImpl( uint64_t exponent );
+
+    // Divides inplace by other number and stores the remainder in out_remainder, which cannot be this number.
+    void DivideWithRemainder( const SimpleBigNum& other, SimpleBigNum& out_remainder );
 
-    // [NOTE]: number is keeped as little endian with base 256.
-    TRawNumberDigits m_numberLittleEndian;
+    // Selects division method based on sizes of the numbers. Stores quotient in this number and remainder in out_remainder.
+    // Other number has to have at least 2 limbs and cannot be greater then this number.
+    void DivideImpl( const SimpleBigNum& other, SimpleBigNum& out_remainder );
+
+    // Implementation of division using schoolbook long division. Stores quotient in this number and remainder in out_remainder.
+    // Other number has to have at least 2 limbs and cannot be greater then this number.
+    void DivideImpl_Schoolbook( const SimpleBigNum& other, SimpleBigNum& out_remainder );
+
+    // Implementation of division using Burnikel-Ziegler recursive method. Stores quotient in this number and remainder in out_remainder.
+    void DivideImpl_BurnikelZiegler( const SimpleBigNum& other, SimpleBigNum& out_remainder );
+
+    // Divides number of 2 blocks by normalized divisor of blockSize limbs. Number has to be less then divisor * B^blockSize.
+    static void DivideImpl_BurnikelZiegler2By1( const SimpleBigNum& number, const SimpleBigNum& divisor, uint32_t blockSize, SimpleBigNum& out_quotient, SimpleBigNum& out_remainder );
+
+    // Divides number of 3 halves by normalized divisor of 2 halves of halfSize limbs. Number has to be less then divisor * B^halfSize.
+    static void DivideImpl_BurnikelZiegler3By2( const SimpleBigNum& number, const SimpleBigNum& divisor, uint32_t halfSize, SimpleBigNum& out_quotient, SimpleBigNum& out_remainder );
+
+    // Implementation of division using reciprocal estimated with Newton's method. Stores quotient in this number and remainder in out_remainder.
+    void DivideImpl_Newton( const SimpleBigNum& other, SimpleBigNum& out_remainder );
+
+    // [NOTE]: number is keeped as little endian with base 2^64.
+    // Buffer is aligned and zero padded to SIMD_ALIGNMENT, so simd kernels can process whole vectors.
+    TLimbs m_numberLittleEndian{ GetAllocator() };
 };
 
 ////////////////////////////////////////////////////////////////////////
@@ -157,6 +367,13 @@ inline SimpleBigNum& SimpleBigNum::operator/=( const SimpleBigNum& other )
     return *this;
 }
 
+////////////////////////////////////////////////////////////////////////
+inline SimpleBigNum& SimpleBigNum::operator%=( const SimpleBigNum& other )
+{
+    Mod( other );
+    return *this;
+}
+
 ////////////////////////////////////////////////////////////////////////
 inline SimpleBigNum& SimpleBigNum::operator<<( uint32_t value )
 {
@@ -207,4 +424,87 @@ inline bool SimpleBigNum::operator!=( const SimpleBigNum& other ) const
     return !IsEqualTo( other );
 }
 
+////////////////////////////////////////////////////////////////////////
+inline bool SimpleBigNum::IsGreaterOrEqualTo( uint64_t other ) const
+{
+    return !IsLessThen( other );
+}
+
+////////////////////////////////////////////////////////////////////////
+inline bool SimpleBigNum::IsLessOrEqualTo( uint64_t other ) const
+{
+    return !IsGreaterThen( other );
+}
+
+////////////////////////////////////////////////////////////////////////
+inline SimpleBigNum& SimpleBigNum::operator+=( uint64_t other )
+{
+    Add( other );
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////
+inline SimpleBigNum& SimpleBigNum::operator-=( uint64_t other )
+{
+    Subtruct( other );
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////
+inline SimpleBigNum& SimpleBigNum::operator*=( uint64_t other )
+{
+    Multiply( other );
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////
+inline SimpleBigNum& SimpleBigNum::operator/=( uint64_t other )
+{
+    Divide( other );
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////
+inline SimpleBigNum& SimpleBigNum::operator%=( uint64_t other )
+{
+    Mod( other );
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////
+inline bool SimpleBigNum::operator>( uint64_t other ) const
+{
+    return IsGreaterThen( other );
+}
+
+////////////////////////////////////////////////////////////////////////
+inline bool SimpleBigNum::operator<( uint64_t other ) const
+{
+    return IsLessThen( other );
+}
+
+////////////////////////////////////////////////////////////////////////
+inline bool SimpleBigNum::operator<=( uint64_t other ) const
+{
+    return IsLessOrEqualTo( other );
+}
+
+////////////////////////////////////////////////////////////////////////
+inline bool SimpleBigNum::operator>=( uint64_t other ) const
+{
+    return IsGreaterOrEqualTo( other );
+}
+
+////////////////////////////////////////////////////////////////////////
+inline bool SimpleBigNum::operator==( uint64_t other ) const
+{
+    return IsEqualTo( other );
+}
+
+////////////////////////////////////////////////////////////////////////
+inline bool SimpleBigNum::operator!=( uint64_t other ) const
+{
+    return !IsEqualTo( other );
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "bigNum.h"
+
+namespace sbn
+{
+namespace internal
+{
+class ModularMultiplier;
+}
+
+// Class raises fixed base to many exponents modulo fixed modulus.
+// Powers base^(2^(k*i)) are precomputed once, so every exponentiation needs no squarings and only about
+// exponentBits / k + 2^k modular multiplications, where k is the window size chosen for the maximal exponent size.
+class FixedBaseExponentiator
+{
+public:
+    // Ctor. Precomputes powers of the base for exponents of up to maxExponentBits bits.
+    FixedBaseExponentiator( const SimpleBigNum& base, const SimpleBigNum& modulus, uint32_t maxExponentBits );
+
+    // Dtor.
+    ~FixedBaseExponentiator();
+
+    // Returns the modulus.
+    const SimpleBigNum& GetModulus() const;
+
+    // Stores base^exponent mod modulus in out_result. Exponents longer then maxExponentBits are computed using SimpleBigNum::PowMod.
+    // [WARNING]: Any number modulo zero is zero.
+    void PowMod( const SimpleBigNum& exponent, SimpleBigNum& out_result ) const;
+
+private:
+    SimpleBigNum m_base;
+    SimpleBigNum m_modulus;
+    // Not set for modulus equal to zero or one.
+    std::unique_ptr< internal::ModularMultiplier > m_multiplier;
+    uint32_t m_windowSize = 1;
+    // base^(2^(m_windowSize*i)) in the internal form of the multiplier.
+    std::vector< SimpleBigNum > m_powers;
+};
+
+}
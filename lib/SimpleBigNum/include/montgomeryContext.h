@@ -0,0 +1,43 @@
+#pragma once
+#include "bigNum.h"
+
+namespace sbn
+{
+
+// Class performs modular multiplications for a fixed odd modulus in Montgomery form ( number * R mod modulus, where R = B^n
+// and n is the number of limbs of the modulus ). Division by the modulus is replaced by Montgomery reduction, which costs
+// about as much as basecase multiplication of the modulus size.
+class MontgomeryContext
+{
+public:
+    // Ctor. Precomputes R^2 mod modulus and -modulus^-1 mod B.
+    // [WARNING]: Modulus has to be odd.
+    explicit MontgomeryContext( const SimpleBigNum& modulus );
+
+    // Returns the modulus.
+    const SimpleBigNum& GetModulus() const;
+
+    // Converts number inplace to Montgomery form.
+    void ToMontgomeryForm( SimpleBigNum& number ) const;
+
+    // Converts number inplace from Montgomery form back to the normal one.
+    void FromMontgomeryForm( SimpleBigNum& number ) const;
+
+    // Multiplies inplace by other number. Both numbers and the result are in Montgomery form.
+    void MulMod( SimpleBigNum& number, const SimpleBigNum& other ) const;
+
+    // Squares inplace. Number and the result are in Montgomery form.
+    void SqrMod( SimpleBigNum& number ) const;
+
+private:
+    // Replaces number less then modulus * R with number * R^-1 mod modulus.
+    void Reduce( SimpleBigNum& number ) const;
+
+    SimpleBigNum m_modulus;
+    // R^2 mod modulus
+    SimpleBigNum m_rSquared;
+    // -modulus^-1 mod B
+    uint64_t m_modulusInverse = 0;
+};
+
+}
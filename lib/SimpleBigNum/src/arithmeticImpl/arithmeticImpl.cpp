@@ -1,28 +1,276 @@
 #include "arithmeticImpl.h"
+#include <cstdlib>
+#include <cstring>
 #include "generic/arithmeticImplGeneric.h"
+#include "sse/arithmeticImplSee.h"
+#include "avx2/arithmeticImplAvx2.h"
+#include "avx512/arithmeticImplAvx512.h"
+#include "../tools/cpuInfo/cpuInfo.h"
 
 namespace sbn
 {
 namespace internal
 {
+namespace helpers
+{
+
+// Table of kernels used by arithmeticImpl functions.
+struct ImplTable
+{
+    void ( *m_addInplaceImpl )( TRawBufferPtr, const TConstRawBufferPtr, const uint32_t );
+    void ( *m_sustructInplaceImpl )( TRawBufferPtr, const TConstRawBufferPtr, const uint32_t );
+    void ( *m_multiplyInplaceImpl )( TConstRawBufferPtr, const uint32_t, TConstRawBufferPtr, const uint32_t, TRawBufferPtr );
+    void ( *m_squareInplaceImpl )( TConstRawBufferPtr, const uint32_t, TRawBufferPtr );
+    TDigitType ( *m_addDigitInplaceImpl )( TRawBufferPtr, const uint32_t, const TDigitType );
+    void ( *m_subtructDigitInplaceImpl )( TRawBufferPtr, const uint32_t, const TDigitType );
+    TDigitType ( *m_multiplyByDigitInplaceImpl )( TRawBufferPtr, const uint32_t, const TDigitType );
+    TDigitType ( *m_divideByDigitInplaceImpl )( TRawBufferPtr, const uint32_t, const TDigitType );
+    void ( *m_divideInplaceImpl )( TRawBufferPtr, const uint32_t, TConstRawBufferPtr, const uint32_t, TRawBufferPtr );
+    TDigitType ( *m_montgomeryReduceInplaceImpl )( TRawBufferPtr, TConstRawBufferPtr, const uint32_t, const TDigitType );
+    TDigitType ( *m_shiftLeftInplaceImpl )( TRawBufferPtr, const uint32_t, const uint32_t );
+    void ( *m_shiftRightInplaceImpl )( TRawBufferPtr, const uint32_t, const uint32_t );
+    bool ( *m_isDecimalStringImpl )( const char*, const size_t );
+    void ( *m_readDecimalChunksImpl )( const char*, const uint32_t, TRawBufferPtr );
+    void ( *m_writeDecimalChunksImpl )( TConstRawBufferPtr, const uint32_t, char* );
+    ImplType m_type;
+};
+
+// Names of implementation types accepted by SBN_ARITHMETIC_IMPL environment variable.
+static const char* const IMPL_TYPE_NAMES[] = { "generic", "sse", "avx2", "avx512" };
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static ImplTable CreateImplTable( ImplType type )
+{
+    // Start with generic kernels and replace them with better ones available for given type.
+    ImplTable table;
+    table.m_addInplaceImpl = generic::AddInplaceImpl;
+    table.m_sustructInplaceImpl = generic::SustructInplaceImpl;
+    table.m_multiplyInplaceImpl = generic::MultiplyInplaceImpl;
+    table.m_squareInplaceImpl = generic::SquareInplaceImpl;
+    table.m_addDigitInplaceImpl = generic::AddDigitInplaceImpl;
+    table.m_subtructDigitInplaceImpl = generic::SubtructDigitInplaceImpl;
+    table.m_multiplyByDigitInplaceImpl = generic::MultiplyByDigitInplaceImpl;
+    table.m_divideByDigitInplaceImpl = generic::DivideByDigitInplaceImpl;
+    table.m_divideInplaceImpl = generic::DivideInplaceImpl;
+    table.m_montgomeryReduceInplaceImpl = generic::MontgomeryReduceInplaceImpl;
+    table.m_shiftLeftInplaceImpl = generic::ShiftLeftInplaceImpl;
+    table.m_shiftRightInplaceImpl = generic::ShiftRightInplaceImpl;
+    table.m_isDecimalStringImpl = generic::IsDecimalStringImpl;
+    table.m_readDecimalChunksImpl = generic::ReadDecimalChunksImpl;
+    table.m_writeDecimalChunksImpl = generic::WriteDecimalChunksImpl;
+    table.m_type = type;
+
+    if( type >= ImplType::Sse )
+    {
+        table.m_addInplaceImpl = sse::AddInplaceImpl;
+        table.m_sustructInplaceImpl = sse::SustructInplaceImpl;
+        table.m_isDecimalStringImpl = sse::IsDecimalStringImpl;
+        table.m_readDecimalChunksImpl = sse::ReadDecimalChunksImpl;
+        table.m_writeDecimalChunksImpl = sse::WriteDecimalChunksImpl;
+    }
+
+    if( type >= ImplType::Avx2 )
+    {
+        table.m_addInplaceImpl = avx2::AddInplaceImpl;
+        table.m_sustructInplaceImpl = avx2::SustructInplaceImpl;
+        table.m_isDecimalStringImpl = avx2::IsDecimalStringImpl;
+        table.m_readDecimalChunksImpl = avx2::ReadDecimalChunksImpl;
+        table.m_writeDecimalChunksImpl = avx2::WriteDecimalChunksImpl;
+    }
+
+    if( type >= ImplType::Avx512 )
+    {
+        table.m_addInplaceImpl = avx512::AddInplaceImpl;
+        table.m_sustructInplaceImpl = avx512::SustructInplaceImpl;
+
+        // IFMA is not part of base AVX-512 feature set, so it has to be checked separately.
+        if( tools::GetCpuFeatures().m_avx512ifma )
+        {
+            table.m_multiplyInplaceImpl = avx512::MultiplyInplaceImplIfma;
+            table.m_squareInplaceImpl = avx512::SquareInplaceImplIfma;
+        }
+    }
+
+    return table;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static ImplType GetBestSupportedImplType()
+{
+    if( IsImplTypeSupported( ImplType::Avx512 ) )
+        return ImplType::Avx512;
+
+    if( IsImplTypeSupported( ImplType::Avx2 ) )
+        return ImplType::Avx2;
+
+    // [NOTE]: Sse type is never selected automatically. Its byte wise prefix scan resolves 2 digits per iteration
+    // and is ~3.5x slower then scalar add with carry chain on 64 bit digits. It can be still forced for testing.
+    return ImplType::Generic;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static ImplType GetStartupImplType()
+{
+    const ImplType bestType = GetBestSupportedImplType();
+
+#if defined( _MSC_VER )
+    char* forcedName = nullptr;
+    size_t forcedNameSize = 0;
+    if( _dupenv_s( &forcedName, &forcedNameSize, "SBN_ARITHMETIC_IMPL" ) != 0 || forcedName == nullptr )
+        return bestType;
+#else
+    const char* forcedName = getenv( "SBN_ARITHMETIC_IMPL" );
+    if( forcedName == nullptr )
+        return bestType;
+#endif
+
+    // Forced type is used only if it is supported, otherwise fall back to the best one.
+    ImplType type = bestType;
+    for( int typeIdx = 0; typeIdx <= ( int )ImplType::Avx512; ++typeIdx )
+    {
+        if( strcmp( forcedName, IMPL_TYPE_NAMES[ typeIdx ] ) == 0 && IsImplTypeSupported( ( ImplType )typeIdx ) )
+            type = ( ImplType )typeIdx;
+    }
+
+#if defined( _MSC_VER )
+    free( forcedName );
+#endif
+    return type;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static ImplTable& GetImplTable()
+{
+    static ImplTable table = CreateImplTable( GetStartupImplType() );
+    return table;
+}
+
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool IsImplTypeSupported( ImplType type )
+{
+    const tools::CpuFeatures& features = tools::GetCpuFeatures();
+    switch( type )
+    {
+    case ImplType::Generic:
+        return true;
+    case ImplType::Sse:
+        return features.m_sse41;
+    case ImplType::Avx2:
+        return features.m_avx2;
+    case ImplType::Avx512:
+        return features.m_avx512;
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+ImplType GetImplType()
+{
+    return helpers::GetImplTable().m_type;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool ForceImplType( ImplType type )
+{
+    if( !IsImplTypeSupported( type ) )
+        return false;
+
+    helpers::GetImplTable() = helpers::CreateImplTable( type );
+    return true;
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void AddInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize )
 {
-    generic::AddInplaceImpl( thisNumberBuffer, otherNumberBuffer, otherNumberSize );
+    helpers::GetImplTable().m_addInplaceImpl( thisNumberBuffer, otherNumberBuffer, otherNumberSize );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void SustructInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize )
 {
-    generic::SustructInplaceImpl( thisNumberBuffer, otherNumberBuffer, otherNumberSize );
+    helpers::GetImplTable().m_sustructInplaceImpl( thisNumberBuffer, otherNumberBuffer, otherNumberSize );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void MultiplyInplaceImpl( TConstRawBufferPtr thisNumberBuffer, const uint32_t thisNumberSize, TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize, TRawBufferPtr out_resultBuffer )
 {
-    generic::MultiplyInplaceImpl( thisNumberBuffer, thisNumberSize, otherNumberBuffer, otherNumberSize, out_resultBuffer );
+    helpers::GetImplTable().m_multiplyInplaceImpl( thisNumberBuffer, thisNumberSize, otherNumberBuffer, otherNumberSize, out_resultBuffer );
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void SquareInplaceImpl( TConstRawBufferPtr numberBuffer, const uint32_t numberSize, TRawBufferPtr out_resultBuffer )
+{
+    helpers::GetImplTable().m_squareInplaceImpl( numberBuffer, numberSize, out_resultBuffer );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TDigitType AddDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType digit )
+{
+    return helpers::GetImplTable().m_addDigitInplaceImpl( numberBuffer, numberSize, digit );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void SubtructDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType digit )
+{
+    helpers::GetImplTable().m_subtructDigitInplaceImpl( numberBuffer, numberSize, digit );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TDigitType MultiplyByDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType digit )
+{
+    return helpers::GetImplTable().m_multiplyByDigitInplaceImpl( numberBuffer, numberSize, digit );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TDigitType DivideByDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType divisor )
+{
+    return helpers::GetImplTable().m_divideByDigitInplaceImpl( numberBuffer, numberSize, divisor );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void DivideInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, TConstRawBufferPtr divisorBuffer, const uint32_t divisorSize, TRawBufferPtr out_quotientBuffer )
+{
+    helpers::GetImplTable().m_divideInplaceImpl( numberBuffer, numberSize, divisorBuffer, divisorSize, out_quotientBuffer );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TDigitType MontgomeryReduceInplaceImpl( TRawBufferPtr numberBuffer, TConstRawBufferPtr modulusBuffer, const uint32_t modulusSize, const TDigitType modulusInverse )
+{
+    return helpers::GetImplTable().m_montgomeryReduceInplaceImpl( numberBuffer, modulusBuffer, modulusSize, modulusInverse );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TDigitType ShiftLeftInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const uint32_t bitsShift )
+{
+    return helpers::GetImplTable().m_shiftLeftInplaceImpl( numberBuffer, numberSize, bitsShift );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void ShiftRightInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const uint32_t bitsShift )
+{
+    helpers::GetImplTable().m_shiftRightInplaceImpl( numberBuffer, numberSize, bitsShift );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool IsDecimalStringImpl( const char* string, const size_t stringSize )
+{
+    return helpers::GetImplTable().m_isDecimalStringImpl( string, stringSize );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void ReadDecimalChunksImpl( const char* digits, const uint32_t numberOfChunks, TRawBufferPtr out_chunks )
+{
+    helpers::GetImplTable().m_readDecimalChunksImpl( digits, numberOfChunks, out_chunks );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void WriteDecimalChunksImpl( TConstRawBufferPtr chunks, const uint32_t numberOfChunks, char* out_digits )
+{
+    helpers::GetImplTable().m_writeDecimalChunksImpl( chunks, numberOfChunks, out_digits );
+}
+
+}
 }
-}
\ No newline at end of file
@@ -6,6 +6,29 @@ namespace sbn
 namespace internal
 {
 
+// Type of implementation of the kernels. Every type can use kernels of all previous types.
+enum class ImplType
+{
+    Generic,
+    Sse,
+    Avx2,
+    Avx512
+};
+
+// Returns true if given implementation type can be used on current cpu.
+bool IsImplTypeSupported( ImplType type );
+
+// Returns currently used implementation type. At startup the best one supported by the cpu is selected,
+// unless other one is forced by SBN_ARITHMETIC_IMPL environment variable ( generic, sse, avx2 or avx512 ).
+ImplType GetImplType();
+
+// Forces usage of given implementation type. Returns false if it is not supported by the cpu.
+// [WARNING]: Not thread safe, meant to be used by tests and benchmarks.
+bool ForceImplType( ImplType type );
+
+// [NOTE]: Buffers of SimpleBigNum numbers are aligned to SIMD_ALIGNMENT and zero padded to the multiple of it,
+// so Add and Subtruct kernels are allowed to read and write whole simd vectors past the end of the numbers.
+
 // Adds inplace otherNumber to this number. Result is accumulated in thisNumberBuffer.
 // Assumes that thisNumberBuffer is big enough to hold the result.
 void AddInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize );
@@ -16,12 +39,61 @@ void AddInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr ot
 void SustructInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize );
 
 // Multiplies thisNumberBuffer and otherNumberBuffer. Result is stored in out_resultBuffer.
-// Assumes that thisNumberBuffer is big enough to hold the result.
+// Assumes that out_resultBuffer is big enough to hold the result ( thisNumberSize + otherNumberSize digits ) and is zeroed.
 void MultiplyInplaceImpl(
     TConstRawBufferPtr thisNumberBuffer, const uint32_t thisNumberSize,
     TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize,
     TRawBufferPtr out_resultBuffer
 );
 
+// Squares numberBuffer. Result is stored in out_resultBuffer.
+// Assumes that out_resultBuffer is big enough to hold the result ( 2 * numberSize digits ) and is zeroed.
+void SquareInplaceImpl( TConstRawBufferPtr numberBuffer, const uint32_t numberSize, TRawBufferPtr out_resultBuffer );
+
+// Single digit kernels. They work on exact number size and do not need padded buffers.
+
+// Adds digit to the number. Returns carry out of the most significant digit.
+TDigitType AddDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType digit );
+
+// Subtructs digit from the number.
+// WARNING! - Assumes that the number is not less then the digit.
+void SubtructDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType digit );
+
+// Multiplies the number by digit. Returns the most significant digit of the result, that does not fit into numberSize digits.
+TDigitType MultiplyByDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType digit );
+
+// Divides the number by divisor, which cannot be zero. Quotient is stored in numberBuffer, remainder is returned.
+TDigitType DivideByDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType divisor );
+
+// Divides the number by divisor using schoolbook long division. Quotient ( numberSize - divisorSize digits ) is stored
+// in out_quotientBuffer, remainder replaces the lowest divisorSize digits of numberBuffer and the rest of them is zeroed.
+// Divisor has to have at least 2 digits and has to be normalized ( the most significant bit of its top digit is set ).
+// Top digit of the number has to be less then the top digit of the divisor, what is achieved by extending shifted number by one digit.
+void DivideInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, TConstRawBufferPtr divisorBuffer, const uint32_t divisorSize, TRawBufferPtr out_quotientBuffer );
+
+// Montgomery reduction of the number of 2 * modulusSize digits, which has to be less then modulus * B^modulusSize.
+// Modulus has to be odd and modulusInverse equal to -modulus^-1 mod B. Result ( number * B^-modulusSize mod modulus,
+// increased by the modulus at most once ) replaces the upper modulusSize digits of numberBuffer, its carry digit is returned.
+TDigitType MontgomeryReduceInplaceImpl( TRawBufferPtr numberBuffer, TConstRawBufferPtr modulusBuffer, const uint32_t modulusSize, const TDigitType modulusInverse );
+
+// Shifts inplace number left by given amount of bits, which has to be less then DIGIT_BITS.
+// Returns bits shifted out of the most significant digit.
+TDigitType ShiftLeftInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const uint32_t bitsShift );
+
+// Shifts inplace number right by given amount of bits, which has to be less then DIGIT_BITS.
+void ShiftRightInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const uint32_t bitsShift );
+
+// Decimal string kernels.
+
+// Returns true if all characters of the string are decimal digits.
+bool IsDecimalStringImpl( const char* string, const size_t stringSize );
+
+// Parses numberOfChunks groups of DECIMAL_CHUNK_DIGITS decimal digits, which have to be valid. Chunks are stored in the order of the string.
+void ReadDecimalChunksImpl( const char* digits, const uint32_t numberOfChunks, TRawBufferPtr out_chunks );
+
+// Writes numberOfChunks chunks, which have to be less then DECIMAL_CHUNK_BASE, as DECIMAL_CHUNK_DIGITS decimal digits each
+// ( padded with leading zeros ). Chunks are written in the order of the buffer.
+void WriteDecimalChunksImpl( TConstRawBufferPtr chunks, const uint32_t numberOfChunks, char* out_digits );
+
+}
 }
-}
\ No newline at end of file
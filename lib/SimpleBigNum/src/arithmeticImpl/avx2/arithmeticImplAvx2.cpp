@@ -0,0 +1,253 @@
+#include "arithmeticImplAvx2.h"
+#include <immintrin.h>
+#include "../sse/arithmeticImplSee.h"
+
+namespace sbn
+{
+namespace internal
+{
+namespace avx2
+{
+#define SIMD_DIGITS 4
+
+////////////////
+// Carries between 64 bit lanes are resolved with carry-lookahead done on lane masks:
+// G - lanes, which generate carry ( sum overflowed ),
+// P - lanes, which propagate incoming carry ( sum is equal to BASE_MINUS_ONE ).
+// Treating masks as integers, ( ( G << 1 ) + P + carryIn ) ^ P gives mask of lanes, that receive carry.
+// Bit SIMD_DIGITS of ( G << 1 ) + P + carryIn is carry out of whole vector.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline __m256i unsignedLessThen( const __m256i a, const __m256i b )
+{
+    // AVX2 has only signed comparison, so flip the sign bits first.
+    const __m256i SIGN_BIT = _mm256_set1_epi64x( ( long long )0x8000000000000000ull );
+    return _mm256_cmpgt_epi64( _mm256_xor_si256( b, SIGN_BIT ), _mm256_xor_si256( a, SIGN_BIT ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline __m256i laneMaskToVector( uint32_t laneMask )
+{
+    // Expands 4 bit mask into vector with all bits set in selected lanes.
+    const __m256i LANE_BITS = _mm256_set_epi64x( 8, 4, 2, 1 );
+    const __m256i maskVec = _mm256_and_si256( _mm256_set1_epi64x( laneMask ), LANE_BITS );
+    return _mm256_cmpeq_epi64( maskVec, LANE_BITS );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline __m256i addWithCarry( const __m256i thisVec, const __m256i otherVec, uint32_t& in_out_carry )
+{
+    const __m256i BASE_MINUS_ONE_CONST = _mm256_set1_epi64x( -1 );
+
+    const __m256i sum = _mm256_add_epi64( thisVec, otherVec );
+    const uint32_t generate = ( uint32_t )_mm256_movemask_pd( _mm256_castsi256_pd( unsignedLessThen( sum, thisVec ) ) );
+    const uint32_t propagate = ( uint32_t )_mm256_movemask_pd( _mm256_castsi256_pd( _mm256_cmpeq_epi64( sum, BASE_MINUS_ONE_CONST ) ) );
+
+    const uint32_t carries = ( generate << 1 ) + propagate + in_out_carry;
+    in_out_carry = carries >> SIMD_DIGITS;
+
+    // Adding one is the same as subtracting all ones:
+    const __m256i carryVec = laneMaskToVector( ( carries ^ propagate ) & 0xF );
+    return _mm256_sub_epi64( sum, carryVec );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline __m256i subtructWithBorrow( const __m256i thisVec, const __m256i otherVec, uint32_t& in_out_borrow )
+{
+    // Borrows are resolved the same way as carries:
+    // G - lanes, which generate borrow ( this digit is less then other digit ),
+    // P - lanes, which propagate incoming borrow ( difference is equal to 0 ).
+    const __m256i ZERO = _mm256_setzero_si256();
+
+    const __m256i difference = _mm256_sub_epi64( thisVec, otherVec );
+    const uint32_t generate = ( uint32_t )_mm256_movemask_pd( _mm256_castsi256_pd( unsignedLessThen( thisVec, otherVec ) ) );
+    const uint32_t propagate = ( uint32_t )_mm256_movemask_pd( _mm256_castsi256_pd( _mm256_cmpeq_epi64( difference, ZERO ) ) );
+
+    const uint32_t borrows = ( generate << 1 ) + propagate + in_out_borrow;
+    in_out_borrow = borrows >> SIMD_DIGITS;
+
+    // Subtracting one is the same as adding all ones:
+    const __m256i borrowVec = laneMaskToVector( ( borrows ^ propagate ) & 0xF );
+    return _mm256_add_epi64( difference, borrowVec );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void AddInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize )
+{
+    // [NOTE]: Buffers are aligned and zero padded, so there is no need to handle the tail separately.
+    uint32_t carry = 0;
+    uint32_t digitIdx = 0;
+    for( ; digitIdx < otherNumberSize; digitIdx += SIMD_DIGITS )
+    {
+        const __m256i thisNumberBufferVec = _mm256_load_si256( ( const __m256i* )&thisNumberBuffer[ digitIdx ] );
+        const __m256i otherNumberBufferVec = _mm256_load_si256( ( const __m256i* )&otherNumberBuffer[ digitIdx ] );
+        _mm256_store_si256( ( __m256i* )&thisNumberBuffer[ digitIdx ], addWithCarry( thisNumberBufferVec, otherNumberBufferVec, carry ) );
+    }
+
+    const __m256i ZERO = _mm256_setzero_si256();
+
+    while( carry != 0 )
+    {
+        const __m256i thisNumberBufferVec = _mm256_load_si256( ( const __m256i* )&thisNumberBuffer[ digitIdx ] );
+        _mm256_store_si256( ( __m256i* )&thisNumberBuffer[ digitIdx ], addWithCarry( thisNumberBufferVec, ZERO, carry ) );
+        digitIdx += SIMD_DIGITS;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void SustructInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize )
+{
+    // [NOTE]: Buffers are aligned and zero padded, so there is no need to handle the tail separately.
+    uint32_t borrow = 0;
+    uint32_t digitIdx = 0;
+    for( ; digitIdx < otherNumberSize; digitIdx += SIMD_DIGITS )
+    {
+        const __m256i thisNumberBufferVec = _mm256_load_si256( ( const __m256i* )&thisNumberBuffer[ digitIdx ] );
+        const __m256i otherNumberBufferVec = _mm256_load_si256( ( const __m256i* )&otherNumberBuffer[ digitIdx ] );
+        _mm256_store_si256( ( __m256i* )&thisNumberBuffer[ digitIdx ], subtructWithBorrow( thisNumberBufferVec, otherNumberBufferVec, borrow ) );
+    }
+
+    const __m256i ZERO = _mm256_setzero_si256();
+
+    while( borrow != 0 )
+    {
+        const __m256i thisNumberBufferVec = _mm256_load_si256( ( const __m256i* )&thisNumberBuffer[ digitIdx ] );
+        _mm256_store_si256( ( __m256i* )&thisNumberBuffer[ digitIdx ], subtructWithBorrow( thisNumberBufferVec, ZERO, borrow ) );
+        digitIdx += SIMD_DIGITS;
+    }
+}
+
+////////////////
+// Decimal kernels use the same method as the sse ones ( see sse/arithmeticImplSee.cpp ), with two chunks
+// processed in separate 128 bit lanes.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline void parse16DigitsPair( const char* firstDigits, const char* secondDigits, uint64_t& out_first, uint64_t& out_second )
+{
+    const __m256i ASCII_ZERO = _mm256_set1_epi8( '0' );
+    const __m256i PAIR_MULTIPLIERS = _mm256_setr_epi8(
+        10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1 );
+    const __m256i QUADRUPLE_MULTIPLIERS = _mm256_setr_epi16( 100, 1, 100, 1, 100, 1, 100, 1, 100, 1, 100, 1, 100, 1, 100, 1 );
+    const __m256i OCTUPLE_MULTIPLIERS = _mm256_setr_epi16( 10000, 1, 10000, 1, 10000, 1, 10000, 1, 10000, 1, 10000, 1, 10000, 1, 10000, 1 );
+
+    const __m256i digits = _mm256_inserti128_si256(
+        _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* )firstDigits ) ), _mm_loadu_si128( ( const __m128i* )secondDigits ), 1 );
+    const __m256i pairs = _mm256_maddubs_epi16( _mm256_sub_epi8( digits, ASCII_ZERO ), PAIR_MULTIPLIERS );
+    const __m256i quadruples = _mm256_madd_epi16( pairs, QUADRUPLE_MULTIPLIERS );
+    const __m256i octuples = _mm256_madd_epi16( _mm256_packus_epi32( quadruples, quadruples ), OCTUPLE_MULTIPLIERS );
+
+    out_first = ( uint64_t )( uint32_t )_mm256_extract_epi32( octuples, 0 ) * 100000000 + ( uint32_t )_mm256_extract_epi32( octuples, 1 );
+    out_second = ( uint64_t )( uint32_t )_mm256_extract_epi32( octuples, 4 ) * 100000000 + ( uint32_t )_mm256_extract_epi32( octuples, 5 );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline __m256i quadrupleDigits( const __m256i quadruples )
+{
+    const __m256i RECIPROCALS = _mm256_setr_epi16(
+        8389, 5243, 13108, ( short )32768, 8389, 5243, 13108, ( short )32768, 8389, 5243, 13108, ( short )32768, 8389, 5243, 13108, ( short )32768 );
+    const __m256i SHIFTS = _mm256_setr_epi16(
+        1 << 7, 1 << 11, 1 << 13, ( short )( 1 << 15 ), 1 << 7, 1 << 11, 1 << 13, ( short )( 1 << 15 ),
+        1 << 7, 1 << 11, 1 << 13, ( short )( 1 << 15 ), 1 << 7, 1 << 11, 1 << 13, ( short )( 1 << 15 ) );
+
+    const __m256i prefixes = _mm256_mulhi_epu16( _mm256_mulhi_epu16( quadruples, RECIPROCALS ), SHIFTS );
+    const __m256i previousPrefixes = _mm256_slli_epi64( _mm256_mullo_epi16( prefixes, _mm256_set1_epi16( 10 ) ), 16 );
+    return _mm256_sub_epi16( prefixes, previousPrefixes );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline __m256i format16DigitsPair( const __m256i octuples )
+{
+    const __m256i DIVIDE_BY_10000 = _mm256_set1_epi32( ( int )0xD1B71759 );
+    const __m256i FIRST_QUADRUPLES = _mm256_setr_epi8(
+        0, 1, 0, 1, 0, 1, 0, 1, 2, 3, 2, 3, 2, 3, 2, 3, 0, 1, 0, 1, 0, 1, 0, 1, 2, 3, 2, 3, 2, 3, 2, 3 );
+    const __m256i SECOND_QUADRUPLES = _mm256_setr_epi8(
+        8, 9, 8, 9, 8, 9, 8, 9, 10, 11, 10, 11, 10, 11, 10, 11, 8, 9, 8, 9, 8, 9, 8, 9, 10, 11, 10, 11, 10, 11, 10, 11 );
+
+    const __m256i highQuadruples = _mm256_srli_epi64( _mm256_mul_epu32( octuples, DIVIDE_BY_10000 ), 45 );
+    const __m256i lowQuadruples = _mm256_sub_epi32( octuples, _mm256_mul_epu32( highQuadruples, _mm256_set1_epi32( 10000 ) ) );
+    const __m256i quadruples = _mm256_slli_epi16( _mm256_or_si256( highQuadruples, _mm256_slli_epi64( lowQuadruples, 16 ) ), 2 );
+
+    const __m256i firstDigits = quadrupleDigits( _mm256_shuffle_epi8( quadruples, FIRST_QUADRUPLES ) );
+    const __m256i secondDigits = quadrupleDigits( _mm256_shuffle_epi8( quadruples, SECOND_QUADRUPLES ) );
+    return _mm256_add_epi8( _mm256_packus_epi16( firstDigits, secondDigits ), _mm256_set1_epi8( '0' ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline uint64_t parseTopDigits( const char* digits )
+{
+    return ( uint64_t )( digits[ 0 ] - '0' ) * 100 + ( uint64_t )( digits[ 1 ] - '0' ) * 10 + ( uint64_t )( digits[ 2 ] - '0' );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline void formatTopDigits( uint32_t topDigits, char* out_digits )
+{
+    out_digits[ 0 ] = ( char )( '0' + topDigits / 100 );
+    out_digits[ 1 ] = ( char )( '0' + topDigits / 10 % 10 );
+    out_digits[ 2 ] = ( char )( '0' + topDigits % 10 );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool IsDecimalStringImpl( const char* string, const size_t stringSize )
+{
+    constexpr size_t VECTOR_BYTES = 32;
+    const __m256i ASCII_ZERO = _mm256_set1_epi8( '0' );
+    const __m256i NINE = _mm256_set1_epi8( 9 );
+
+    size_t charIdx = 0;
+    for( ; charIdx + VECTOR_BYTES <= stringSize; charIdx += VECTOR_BYTES )
+    {
+        const __m256i values = _mm256_sub_epi8( _mm256_loadu_si256( ( const __m256i* )&string[ charIdx ] ), ASCII_ZERO );
+        if( ( uint32_t )_mm256_movemask_epi8( _mm256_cmpeq_epi8( _mm256_max_epu8( values, NINE ), NINE ) ) != 0xFFFFFFFF )
+            return false;
+    }
+
+    return sse::IsDecimalStringImpl( string + charIdx, stringSize - charIdx );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+void ReadDecimalChunksImpl( const char* digits, const uint32_t numberOfChunks, TRawBufferPtr out_chunks )
+{
+    uint32_t chunkIdx = 0;
+    for( ; chunkIdx + 2 <= numberOfChunks; chunkIdx += 2 )
+    {
+        const char* firstDigits = digits + ( size_t )chunkIdx * DECIMAL_CHUNK_DIGITS;
+        const char* secondDigits = firstDigits + DECIMAL_CHUNK_DIGITS;
+        uint64_t firstLow;
+        uint64_t secondLow;
+        parse16DigitsPair( firstDigits + 3, secondDigits + 3, firstLow, secondLow );
+
+        out_chunks[ chunkIdx ] = parseTopDigits( firstDigits ) * 10000000000000000ull + firstLow;
+        out_chunks[ chunkIdx + 1 ] = parseTopDigits( secondDigits ) * 10000000000000000ull + secondLow;
+    }
+
+    sse::ReadDecimalChunksImpl( digits + ( size_t )chunkIdx * DECIMAL_CHUNK_DIGITS, numberOfChunks - chunkIdx, out_chunks + chunkIdx );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+void WriteDecimalChunksImpl( TConstRawBufferPtr chunks, const uint32_t numberOfChunks, char* out_digits )
+{
+    uint32_t chunkIdx = 0;
+    for( ; chunkIdx + 2 <= numberOfChunks; chunkIdx += 2 )
+    {
+        char* firstDigits = out_digits + ( size_t )chunkIdx * DECIMAL_CHUNK_DIGITS;
+        char* secondDigits = firstDigits + DECIMAL_CHUNK_DIGITS;
+        const uint64_t firstLow = chunks[ chunkIdx ] % 10000000000000000ull;
+        const uint64_t secondLow = chunks[ chunkIdx + 1 ] % 10000000000000000ull;
+
+        const __m256i octuples = _mm256_set_epi64x(
+            ( long long )( secondLow % 100000000 ), ( long long )( secondLow / 100000000 ),
+            ( long long )( firstLow % 100000000 ), ( long long )( firstLow / 100000000 ) );
+        const __m256i digits = format16DigitsPair( octuples );
+
+        formatTopDigits( ( uint32_t )( chunks[ chunkIdx ] / 10000000000000000ull ), firstDigits );
+        formatTopDigits( ( uint32_t )( chunks[ chunkIdx + 1 ] / 10000000000000000ull ), secondDigits );
+        _mm_storeu_si128( ( __m128i* )( firstDigits + 3 ), _mm256_castsi256_si128( digits ) );
+        _mm_storeu_si128( ( __m128i* )( secondDigits + 3 ), _mm256_extracti128_si256( digits, 1 ) );
+    }
+
+    sse::WriteDecimalChunksImpl( chunks + chunkIdx, numberOfChunks - chunkIdx, out_digits + ( size_t )chunkIdx * DECIMAL_CHUNK_DIGITS );
+}
+
+}
+}
+}
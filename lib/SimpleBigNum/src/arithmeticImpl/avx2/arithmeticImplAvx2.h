@@ -0,0 +1,21 @@
+#pragma once
+#include "../typedefs.h"
+
+namespace sbn
+{
+namespace internal
+{
+namespace avx2
+{
+
+// Implements aritheticImpl functions.
+void AddInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize );
+void SustructInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize );
+bool IsDecimalStringImpl( const char* string, const size_t stringSize );
+void ReadDecimalChunksImpl( const char* digits, const uint32_t numberOfChunks, TRawBufferPtr out_chunks );
+void WriteDecimalChunksImpl( TConstRawBufferPtr chunks, const uint32_t numberOfChunks, char* out_digits );
+// -----------------------------------------
+
+}
+}
+}
@@ -0,0 +1,310 @@
+#include "arithmeticImplAvx512.h"
+#include <immintrin.h>
+#include <cstring>
+#include "../generic/arithmeticImplGeneric.h"
+
+// [NOTE]: This file is compiled with AVX-512 instruction set enabled. Inline functions of shared headers ( digitOps.h,
+// std algorithms ) would be emitted here as weak symbols built with AVX-512 instructions and the linker could pick these
+// copies for the generic code too. Only file local helpers are used here.
+
+namespace sbn
+{
+namespace internal
+{
+namespace avx512
+{
+#define SIMD_DIGITS 8
+
+////////////////
+// Carries between 64 bit lanes are resolved with carry-lookahead done on mask registers:
+// G - lanes, which generate carry ( sum overflowed ),
+// P - lanes, which propagate incoming carry ( sum is equal to BASE_MINUS_ONE ).
+// Treating masks as integers, ( ( G << 1 ) + P + carryIn ) ^ P gives mask of lanes, that receive carry.
+// Bit SIMD_DIGITS of ( G << 1 ) + P + carryIn is carry out of whole vector.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline __m512i addWithCarry( const __m512i thisVec, const __m512i otherVec, uint32_t& in_out_carry )
+{
+    const __m512i BASE_MINUS_ONE_CONST = _mm512_set1_epi64( -1 );
+
+    const __m512i sum = _mm512_add_epi64( thisVec, otherVec );
+    const uint32_t generate = ( uint32_t )_mm512_cmplt_epu64_mask( sum, thisVec );
+    const uint32_t propagate = ( uint32_t )_mm512_cmpeq_epi64_mask( sum, BASE_MINUS_ONE_CONST );
+
+    const uint32_t carries = ( generate << 1 ) + propagate + in_out_carry;
+    in_out_carry = carries >> SIMD_DIGITS;
+
+    // Adding one is the same as subtracting all ones:
+    const __mmask8 carryMask = ( __mmask8 )( carries ^ propagate );
+    return _mm512_mask_sub_epi64( sum, carryMask, sum, BASE_MINUS_ONE_CONST );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline __m512i subtructWithBorrow( const __m512i thisVec, const __m512i otherVec, uint32_t& in_out_borrow )
+{
+    // Borrows are resolved the same way as carries:
+    // G - lanes, which generate borrow ( this digit is less then other digit ),
+    // P - lanes, which propagate incoming borrow ( difference is equal to 0 ).
+    const __m512i BASE_MINUS_ONE_CONST = _mm512_set1_epi64( -1 );
+
+    const __m512i difference = _mm512_sub_epi64( thisVec, otherVec );
+    const uint32_t generate = ( uint32_t )_mm512_cmplt_epu64_mask( thisVec, otherVec );
+    const uint32_t propagate = ( uint32_t )_mm512_cmpeq_epi64_mask( difference, _mm512_setzero_si512() );
+
+    const uint32_t borrows = ( generate << 1 ) + propagate + in_out_borrow;
+    in_out_borrow = borrows >> SIMD_DIGITS;
+
+    // Subtracting one is the same as adding all ones:
+    const __mmask8 borrowMask = ( __mmask8 )( borrows ^ propagate );
+    return _mm512_mask_add_epi64( difference, borrowMask, difference, BASE_MINUS_ONE_CONST );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void AddInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize )
+{
+    // [NOTE]: Buffers are aligned and zero padded, so there is no need to handle the tail separately.
+    uint32_t carry = 0;
+    uint32_t digitIdx = 0;
+    for( ; digitIdx < otherNumberSize; digitIdx += SIMD_DIGITS )
+    {
+        const __m512i thisNumberBufferVec = _mm512_load_si512( &thisNumberBuffer[ digitIdx ] );
+        const __m512i otherNumberBufferVec = _mm512_load_si512( &otherNumberBuffer[ digitIdx ] );
+        _mm512_store_si512( &thisNumberBuffer[ digitIdx ], addWithCarry( thisNumberBufferVec, otherNumberBufferVec, carry ) );
+    }
+
+    const __m512i ZERO = _mm512_setzero_si512();
+
+    while( carry != 0 )
+    {
+        const __m512i thisNumberBufferVec = _mm512_load_si512( &thisNumberBuffer[ digitIdx ] );
+        _mm512_store_si512( &thisNumberBuffer[ digitIdx ], addWithCarry( thisNumberBufferVec, ZERO, carry ) );
+        digitIdx += SIMD_DIGITS;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void SustructInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize )
+{
+    // [NOTE]: Buffers are aligned and zero padded, so there is no need to handle the tail separately.
+    uint32_t borrow = 0;
+    uint32_t digitIdx = 0;
+    for( ; digitIdx < otherNumberSize; digitIdx += SIMD_DIGITS )
+    {
+        const __m512i thisNumberBufferVec = _mm512_load_si512( &thisNumberBuffer[ digitIdx ] );
+        const __m512i otherNumberBufferVec = _mm512_load_si512( &otherNumberBuffer[ digitIdx ] );
+        _mm512_store_si512( &thisNumberBuffer[ digitIdx ], subtructWithBorrow( thisNumberBufferVec, otherNumberBufferVec, borrow ) );
+    }
+
+    const __m512i ZERO = _mm512_setzero_si512();
+
+    while( borrow != 0 )
+    {
+        const __m512i thisNumberBufferVec = _mm512_load_si512( &thisNumberBuffer[ digitIdx ] );
+        _mm512_store_si512( &thisNumberBuffer[ digitIdx ], subtructWithBorrow( thisNumberBufferVec, ZERO, borrow ) );
+        digitIdx += SIMD_DIGITS;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IFMA multiplication works in radix 2^52, because vpmadd52luq/vpmadd52huq multiply 52 bit digits and add low/high
+// 52 bits of 8 products to 64 bit accumulators. Accumulators have 12 spare bits, so carries are not propagated until
+// whole column is summed. Numbers are multiplied in chunks of CHUNK_DIGITS digits, each chunk is converted to radix 2^52,
+// multiplied column by column ( SIMD_DIGITS columns at once ), converted back and added to the result.
+namespace helpers
+{
+
+constexpr uint32_t RADIX_BITS = 52;
+constexpr uint64_t RADIX_MASK = ( 1ull << RADIX_BITS ) - 1;
+
+// Maximal number of digits of one chunk and number of radix 2^52 digits needed to hold it.
+constexpr uint32_t CHUNK_DIGITS = 64;
+constexpr uint32_t CHUNK_RADIX_DIGITS = ( CHUNK_DIGITS * DIGIT_BITS + RADIX_BITS - 1 ) / RADIX_BITS;
+// Number of zero radix digits placed before and after the chunk, so all loads of the chunk are in bounds.
+constexpr uint32_t CHUNK_PADDING = SIMD_DIGITS;
+// Radix conversions and column normalization do not pay off for short operands, scalar multiplication is used for them.
+constexpr uint32_t MIN_IFMA_SHORTER_DIGITS = 8;
+constexpr uint32_t MIN_IFMA_LONGER_DIGITS = 16;
+constexpr uint32_t MIN_IFMA_SQUARE_DIGITS = 16;
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static inline uint32_t Min( const uint32_t a, const uint32_t b )
+{
+    return a < b ? a : b;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static inline uint32_t Max( const uint32_t a, const uint32_t b )
+{
+    return a < b ? b : a;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static inline uint8_t AddDigitsWithCarry( uint8_t carry, TDigitType a, TDigitType b, TDigitType& out_result )
+{
+    const TDigitType sum = a + b;
+    const TDigitType result = sum + carry;
+    out_result = result;
+    return ( uint8_t )( ( sum < a ) | ( result < sum ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint32_t ConvertToRadix52( TConstRawBufferPtr numberBuffer, const uint32_t numberSize, uint64_t* out_radixDigits )
+{
+    const uint32_t radixDigitsSize = ( numberSize * DIGIT_BITS + RADIX_BITS - 1 ) / RADIX_BITS;
+    for( uint32_t radixIdx = 0; radixIdx < radixDigitsSize; ++radixIdx )
+    {
+        const uint32_t bitOffset = radixIdx * RADIX_BITS;
+        const uint32_t digitIdx = bitOffset / DIGIT_BITS;
+        const uint32_t shift = bitOffset % DIGIT_BITS;
+
+        uint64_t radixDigit = numberBuffer[ digitIdx ] >> shift;
+        if( shift > DIGIT_BITS - RADIX_BITS && digitIdx + 1 < numberSize )
+            radixDigit |= numberBuffer[ digitIdx + 1 ] << ( DIGIT_BITS - shift );
+
+        out_radixDigits[ radixIdx ] = radixDigit & RADIX_MASK;
+    }
+
+    return radixDigitsSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void ConvertFromRadix52( const uint64_t* radixDigits, TRawBufferPtr out_numberBuffer, const uint32_t numberSize )
+{
+    // [NOTE]: Assumes that radixDigits has two extra zero digits after the number.
+    for( uint32_t digitIdx = 0; digitIdx < numberSize; ++digitIdx )
+    {
+        const uint32_t bitOffset = digitIdx * DIGIT_BITS;
+        const uint32_t radixIdx = bitOffset / RADIX_BITS;
+        const uint32_t shift = bitOffset % RADIX_BITS;
+
+        TDigitType digit = ( radixDigits[ radixIdx ] >> shift ) | ( radixDigits[ radixIdx + 1 ] << ( RADIX_BITS - shift ) );
+        if( shift > 2 * RADIX_BITS - DIGIT_BITS )
+            digit |= radixDigits[ radixIdx + 2 ] << ( 2 * RADIX_BITS - shift );
+
+        out_numberBuffer[ digitIdx ] = digit;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void MultiplyRadix52(
+    const uint64_t* thisRadixDigits, const uint32_t thisSize,
+    const uint64_t* otherPaddedRadixDigits, const uint32_t otherSize,
+    uint64_t* out_resultRadixDigits )
+{
+    const uint32_t resultSize = thisSize + otherSize;
+
+    alignas( 64 ) uint64_t lowSums[ SIMD_DIGITS ];
+    alignas( 64 ) uint64_t highSums[ SIMD_DIGITS ];
+    uint64_t carry = 0;
+    uint64_t previousHighSum = 0;
+
+    for( uint32_t column = 0; column < resultSize; column += SIMD_DIGITS )
+    {
+        // Digit thisRadixDigits[ i ] contributes to columns [ column, column + SIMD_DIGITS ) if column - otherSize < i <= column + SIMD_DIGITS - 1.
+        uint32_t thisIdx = column + 1 > otherSize ? column + 1 - otherSize : 0;
+        const uint32_t lastIdx = Min( thisSize, column + SIMD_DIGITS );
+
+        // Two pairs of accumulators hide latency of madd52 instructions.
+        __m512i lowSumVec0 = _mm512_setzero_si512();
+        __m512i highSumVec0 = _mm512_setzero_si512();
+        __m512i lowSumVec1 = _mm512_setzero_si512();
+        __m512i highSumVec1 = _mm512_setzero_si512();
+        for( ; thisIdx + 1 < lastIdx; thisIdx += 2 )
+        {
+            // Lanes, that fall outside of the other number, read zero padding.
+            const __m512i thisVec0 = _mm512_set1_epi64( thisRadixDigits[ thisIdx ] );
+            const __m512i otherVec0 = _mm512_loadu_si512( &otherPaddedRadixDigits[ CHUNK_PADDING + column - thisIdx ] );
+            lowSumVec0 = _mm512_madd52lo_epu64( lowSumVec0, thisVec0, otherVec0 );
+            highSumVec0 = _mm512_madd52hi_epu64( highSumVec0, thisVec0, otherVec0 );
+
+            const __m512i thisVec1 = _mm512_set1_epi64( thisRadixDigits[ thisIdx + 1 ] );
+            const __m512i otherVec1 = _mm512_loadu_si512( &otherPaddedRadixDigits[ CHUNK_PADDING + column - thisIdx - 1 ] );
+            lowSumVec1 = _mm512_madd52lo_epu64( lowSumVec1, thisVec1, otherVec1 );
+            highSumVec1 = _mm512_madd52hi_epu64( highSumVec1, thisVec1, otherVec1 );
+        }
+
+        if( thisIdx < lastIdx )
+        {
+            const __m512i thisVec0 = _mm512_set1_epi64( thisRadixDigits[ thisIdx ] );
+            const __m512i otherVec0 = _mm512_loadu_si512( &otherPaddedRadixDigits[ CHUNK_PADDING + column - thisIdx ] );
+            lowSumVec0 = _mm512_madd52lo_epu64( lowSumVec0, thisVec0, otherVec0 );
+            highSumVec0 = _mm512_madd52hi_epu64( highSumVec0, thisVec0, otherVec0 );
+        }
+
+        _mm512_store_si512( lowSums, _mm512_add_epi64( lowSumVec0, lowSumVec1 ) );
+        _mm512_store_si512( highSums, _mm512_add_epi64( highSumVec0, highSumVec1 ) );
+
+        // High part of the column belongs to the next column.
+        const uint32_t columnsInBlock = Min( ( uint32_t )SIMD_DIGITS, resultSize - column );
+        for( uint32_t laneIdx = 0; laneIdx < columnsInBlock; ++laneIdx )
+        {
+            carry += lowSums[ laneIdx ] + previousHighSum;
+            out_resultRadixDigits[ column + laneIdx ] = carry & RADIX_MASK;
+            carry >>= RADIX_BITS;
+            previousHighSum = highSums[ laneIdx ];
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void AddChunkProduct( TRawBufferPtr resultBuffer, TConstRawBufferPtr chunkProduct, const uint32_t chunkProductSize )
+{
+    uint8_t carry = 0;
+    for( uint32_t digitIdx = 0; digitIdx < chunkProductSize; ++digitIdx )
+        carry = AddDigitsWithCarry( carry, resultBuffer[ digitIdx ], chunkProduct[ digitIdx ], resultBuffer[ digitIdx ] );
+
+    for( uint32_t digitIdx = chunkProductSize; carry != 0; ++digitIdx )
+        carry = AddDigitsWithCarry( carry, resultBuffer[ digitIdx ], 0, resultBuffer[ digitIdx ] );
+}
+
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void MultiplyInplaceImplIfma( TConstRawBufferPtr thisNumberBuffer, const uint32_t thisNumberSize, TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize, TRawBufferPtr out_resultBuffer )
+{
+    if( helpers::Min( thisNumberSize, otherNumberSize ) < helpers::MIN_IFMA_SHORTER_DIGITS || helpers::Max( thisNumberSize, otherNumberSize ) < helpers::MIN_IFMA_LONGER_DIGITS )
+        return generic::MultiplyInplaceImpl( thisNumberBuffer, thisNumberSize, otherNumberBuffer, otherNumberSize, out_resultBuffer );
+
+    uint64_t thisRadixDigits[ helpers::CHUNK_RADIX_DIGITS ];
+    alignas( 64 ) uint64_t otherPaddedRadixDigits[ helpers::CHUNK_RADIX_DIGITS + 2 * helpers::CHUNK_PADDING ];
+    uint64_t resultRadixDigits[ 2 * helpers::CHUNK_RADIX_DIGITS + 2 ];
+    TDigitType chunkProduct[ 2 * helpers::CHUNK_DIGITS ];
+
+    memset( otherPaddedRadixDigits, 0, helpers::CHUNK_PADDING * sizeof( uint64_t ) );
+
+    for( uint32_t otherBegin = 0; otherBegin < otherNumberSize; otherBegin += helpers::CHUNK_DIGITS )
+    {
+        const uint32_t otherChunkSize = helpers::Min( helpers::CHUNK_DIGITS, otherNumberSize - otherBegin );
+        const uint32_t otherRadixSize = helpers::ConvertToRadix52( &otherNumberBuffer[ otherBegin ], otherChunkSize, &otherPaddedRadixDigits[ helpers::CHUNK_PADDING ] );
+        memset( &otherPaddedRadixDigits[ helpers::CHUNK_PADDING + otherRadixSize ], 0, helpers::CHUNK_PADDING * sizeof( uint64_t ) );
+
+        for( uint32_t thisBegin = 0; thisBegin < thisNumberSize; thisBegin += helpers::CHUNK_DIGITS )
+        {
+            const uint32_t thisChunkSize = helpers::Min( helpers::CHUNK_DIGITS, thisNumberSize - thisBegin );
+            const uint32_t thisRadixSize = helpers::ConvertToRadix52( &thisNumberBuffer[ thisBegin ], thisChunkSize, thisRadixDigits );
+
+            helpers::MultiplyRadix52( thisRadixDigits, thisRadixSize, otherPaddedRadixDigits, otherRadixSize, resultRadixDigits );
+            resultRadixDigits[ thisRadixSize + otherRadixSize ] = 0;
+            resultRadixDigits[ thisRadixSize + otherRadixSize + 1 ] = 0;
+
+            const uint32_t chunkProductSize = thisChunkSize + otherChunkSize;
+            helpers::ConvertFromRadix52( resultRadixDigits, chunkProduct, chunkProductSize );
+            helpers::AddChunkProduct( &out_resultBuffer[ thisBegin + otherBegin ], chunkProduct, chunkProductSize );
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void SquareInplaceImplIfma( TConstRawBufferPtr numberBuffer, const uint32_t numberSize, TRawBufferPtr out_resultBuffer )
+{
+    // Symmetry can not be exploited by column wise kernel, but full IFMA product is still faster then scalar squaring
+    // for operands, that are long enough.
+    if( numberSize < helpers::MIN_IFMA_SQUARE_DIGITS )
+        return generic::SquareInplaceImpl( numberBuffer, numberSize, out_resultBuffer );
+
+    MultiplyInplaceImplIfma( numberBuffer, numberSize, numberBuffer, numberSize, out_resultBuffer );
+}
+
+}
+}
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+#include "../typedefs.h"
+
+namespace sbn
+{
+namespace internal
+{
+namespace avx512
+{
+
+// Implements aritheticImpl functions.
+void AddInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize );
+void SustructInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize );
+// -----------------------------------------
+
+// Implements MultiplyInplaceImpl with AVX-512 IFMA52 instructions. Can be used only if cpu supports IFMA.
+void MultiplyInplaceImplIfma(
+    TConstRawBufferPtr thisNumberBuffer, const uint32_t thisNumberSize,
+    TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize,
+    TRawBufferPtr out_resultBuffer
+);
+
+// Implements SquareInplaceImpl with AVX-512 IFMA52 instructions. Can be used only if cpu supports IFMA.
+void SquareInplaceImplIfma( TConstRawBufferPtr numberBuffer, const uint32_t numberSize, TRawBufferPtr out_resultBuffer );
+
+}
+}
+}
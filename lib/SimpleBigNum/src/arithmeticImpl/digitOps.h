@@ -0,0 +1,200 @@
+#pragma once
+#include "typedefs.h"
+
+#if defined( _MSC_VER ) && defined( _M_X64 )
+#include <intrin.h>
+#define SBN_MSVC_X64_INTRINSICS
+#elif defined( __x86_64__ )
+#include <x86intrin.h>
+#define SBN_GCC_X64_INTRINSICS
+#endif
+
+namespace sbn
+{
+namespace internal
+{
+
+// Helper functions, that operate on single digits. Wraps compiler specific intrinsics.
+
+// Calculates a + b + carry. Stores result in out_result and returns outgoing carry.
+inline uint8_t AddDigitsWithCarry( uint8_t carry, TDigitType a, TDigitType b, TDigitType& out_result );
+
+// Calculates a - b - borrow. Stores result in out_result and returns outgoing borrow.
+inline uint8_t SubtructDigitsWithBorrow( uint8_t borrow, TDigitType a, TDigitType b, TDigitType& out_result );
+
+// Calculates full a * b product. Returns lower digit of the product, higher digit is stored in out_high.
+inline TDigitType MultiplyDigits( TDigitType a, TDigitType b, TDigitType& out_high );
+
+// Divides two digit number ( high, low ) by divisor. Returns quotient, remainder is stored in out_remainder.
+// Quotient has to fit into one digit, so high has to be less then divisor.
+inline TDigitType DivideDigits( TDigitType high, TDigitType low, TDigitType divisor, TDigitType& out_remainder );
+
+// Returns reciprocal of normalized divisor ( with the most significant bit set ) used by DivideDigitsWithReciprocal.
+// Reciprocal is equal to floor( ( B^2 - 1 ) / divisor ) - B.
+inline TDigitType CalcDigitReciprocal( TDigitType normalizedDivisor );
+
+// Same as DivideDigits, but divisor has to be normalized and division is replaced by two multiplications
+// with precalculated reciprocal ( Moller, Granlund "Improved division by invariant integers" ).
+inline TDigitType DivideDigitsWithReciprocal( TDigitType high, TDigitType low, TDigitType normalizedDivisor, TDigitType reciprocal, TDigitType& out_remainder );
+
+// Returns number of leading zero bits of given digit. Digit cannot be zero.
+inline uint32_t CountLeadingZeros( TDigitType digit );
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// IMPLEMENTATION:
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline uint8_t AddDigitsWithCarry( uint8_t carry, TDigitType a, TDigitType b, TDigitType& out_result )
+{
+#if defined( SBN_MSVC_X64_INTRINSICS ) || defined( SBN_GCC_X64_INTRINSICS )
+    unsigned long long result;
+    carry = _addcarry_u64( carry, a, b, &result );
+    out_result = result;
+    return carry;
+#else
+    const TDigitType sum = a + b;
+    const TDigitType result = sum + carry;
+    out_result = result;
+    return ( uint8_t )( ( sum < a ) | ( result < sum ) );
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline uint8_t SubtructDigitsWithBorrow( uint8_t borrow, TDigitType a, TDigitType b, TDigitType& out_result )
+{
+#if defined( SBN_MSVC_X64_INTRINSICS ) || defined( SBN_GCC_X64_INTRINSICS )
+    unsigned long long result;
+    borrow = _subborrow_u64( borrow, a, b, &result );
+    out_result = result;
+    return borrow;
+#else
+    const TDigitType diff = a - b;
+    const TDigitType result = diff - borrow;
+    out_result = result;
+    return ( uint8_t )( ( a < b ) | ( diff < borrow ) );
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline TDigitType MultiplyDigits( TDigitType a, TDigitType b, TDigitType& out_high )
+{
+#if defined( SBN_MSVC_X64_INTRINSICS )
+    unsigned long long high;
+    const TDigitType low = _umul128( a, b, &high );
+    out_high = high;
+    return low;
+#elif defined( __SIZEOF_INT128__ )
+    const unsigned __int128 product = ( unsigned __int128 )a * b;
+    out_high = ( TDigitType )( product >> 64 );
+    return ( TDigitType )product;
+#else
+    // Schoolbook multiplication on 32 bit halves:
+    const TDigitType aLow = a & 0xFFFFFFFF;
+    const TDigitType aHigh = a >> 32;
+    const TDigitType bLow = b & 0xFFFFFFFF;
+    const TDigitType bHigh = b >> 32;
+
+    const TDigitType lowLow = aLow * bLow;
+    const TDigitType lowHigh = aLow * bHigh;
+    const TDigitType highLow = aHigh * bLow;
+    const TDigitType highHigh = aHigh * bHigh;
+
+    const TDigitType middle = ( lowLow >> 32 ) + ( lowHigh & 0xFFFFFFFF ) + ( highLow & 0xFFFFFFFF );
+    out_high = highHigh + ( lowHigh >> 32 ) + ( highLow >> 32 ) + ( middle >> 32 );
+    return ( middle << 32 ) | ( lowLow & 0xFFFFFFFF );
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline TDigitType DivideDigits( TDigitType high, TDigitType low, TDigitType divisor, TDigitType& out_remainder )
+{
+#if defined( SBN_MSVC_X64_INTRINSICS ) && _MSC_VER >= 1920
+    unsigned long long remainder;
+    const TDigitType quotient = _udiv128( high, low, divisor, &remainder );
+    out_remainder = remainder;
+    return quotient;
+#elif defined( __SIZEOF_INT128__ )
+    const unsigned __int128 dividend = ( ( unsigned __int128 )high << DIGIT_BITS ) | low;
+    out_remainder = ( TDigitType )( dividend % divisor );
+    return ( TDigitType )( dividend / divisor );
+#else
+    // Bitwise long division. Remainder may need one more bit then a digit, so its top bit is tracked separately.
+    TDigitType quotient = 0;
+    for( uint32_t bit = 0; bit < DIGIT_BITS; ++bit )
+    {
+        const TDigitType remainderTopBit = high >> ( DIGIT_BITS - 1 );
+        high = ( high << 1 ) | ( low >> ( DIGIT_BITS - 1 ) );
+        low <<= 1;
+        quotient <<= 1;
+        if( remainderTopBit != 0 || high >= divisor )
+        {
+            high -= divisor;
+            quotient |= 1;
+        }
+    }
+
+    out_remainder = high;
+    return quotient;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline TDigitType CalcDigitReciprocal( TDigitType normalizedDivisor )
+{
+    // ( B^2 - 1 ) / divisor - B == ( ( B - 1 - divisor ) * B + B - 1 ) / divisor
+    TDigitType remainder;
+    return DivideDigits( ~normalizedDivisor, BASE_MINUS_ONE, normalizedDivisor, remainder );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline TDigitType DivideDigitsWithReciprocal( TDigitType high, TDigitType low, TDigitType normalizedDivisor, TDigitType reciprocal, TDigitType& out_remainder )
+{
+    // Candidate quotient is the high digit of reciprocal * high + ( high + 1 ) * B + low. It can be one too big
+    // or one too small, both cases are fixed by the adjustments at the end.
+    TDigitType quotientHigh;
+    TDigitType quotientLow = MultiplyDigits( reciprocal, high, quotientHigh );
+    const uint8_t carry = AddDigitsWithCarry( 0, quotientLow, low, quotientLow );
+    AddDigitsWithCarry( carry, quotientHigh, high + 1, quotientHigh );
+
+    TDigitType remainder = low - quotientHigh * normalizedDivisor;
+    if( remainder > quotientLow )
+    {
+        --quotientHigh;
+        remainder += normalizedDivisor;
+    }
+
+    if( remainder >= normalizedDivisor )
+    {
+        ++quotientHigh;
+        remainder -= normalizedDivisor;
+    }
+
+    out_remainder = remainder;
+    return quotientHigh;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline uint32_t CountLeadingZeros( TDigitType digit )
+{
+#if defined( SBN_MSVC_X64_INTRINSICS )
+    unsigned long index;
+    _BitScanReverse64( &index, digit );
+    return 63 - index;
+#elif defined( __GNUC__ )
+    return ( uint32_t )__builtin_clzll( digit );
+#else
+    uint32_t zeros = 0;
+    while( ( digit & ( ( TDigitType )1 << 63 ) ) == 0 )
+    {
+        digit <<= 1;
+        ++zeros;
+    }
+    return zeros;
+#endif
+}
+
+}
+}
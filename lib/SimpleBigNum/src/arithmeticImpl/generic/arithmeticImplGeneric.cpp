@@ -1,5 +1,5 @@
-#pragma once
 #include "arithmeticImplGeneric.h"
+#include "../digitOps.h"
 
 namespace sbn
 {
@@ -11,26 +11,15 @@ namespace generic
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void AddInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize )
 {
-    TDigitType overflow = 0;
+    uint8_t overflow = 0;
     for( uint32_t digitIdx = 0; digitIdx < otherNumberSize; ++digitIdx )
-    {
-        const TDigitType thisDigit = thisNumberBuffer[ digitIdx ];
-        const TDigitType otherDigit = otherNumberBuffer[ digitIdx ];
-        const TDigitType value = thisDigit + otherDigit + overflow;
-        thisNumberBuffer[ digitIdx ] = value;
-        const TDigitType thisDigitPlusOverflow = thisDigit + overflow;
-        overflow = thisDigitPlusOverflow < thisDigit;
-        overflow = ( BASE_MINUS_ONE - thisDigitPlusOverflow ) < otherDigit || overflow;
-    }
+        overflow = AddDigitsWithCarry( overflow, thisNumberBuffer[ digitIdx ], otherNumberBuffer[ digitIdx ], thisNumberBuffer[ digitIdx ] );
 
     // Carry overflow:
     uint32_t digitIdx = otherNumberSize;
     while( overflow != 0 )
     {
-        const TDigitType thisDigit = thisNumberBuffer[ digitIdx ];
-        const TDigitType value = thisDigit + overflow;
-        thisNumberBuffer[ digitIdx ] = value;
-        overflow = value < thisDigit;
+        overflow = AddDigitsWithCarry( overflow, thisNumberBuffer[ digitIdx ], 0, thisNumberBuffer[ digitIdx ] );
         ++digitIdx;
     }
 }
@@ -38,49 +27,288 @@ void AddInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr ot
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void SustructInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize )
 {
-    TDigitType overflow = 0;
+    uint8_t overflow = 0;
     for( uint32_t digitIdx = 0; digitIdx < otherNumberSize; ++digitIdx )
-    {
-        TDigitType thisDigit = thisNumberBuffer[ digitIdx ];
-        TDigitType otherDigit = otherNumberBuffer[ digitIdx ];
-        TDigitType final = thisDigit - otherDigit - overflow;
-        overflow = ( thisDigit < otherDigit ) || ( ( thisDigit == otherDigit ) && overflow );
-        thisNumberBuffer[ digitIdx ] = final;
-    }
+        overflow = SubtructDigitsWithBorrow( overflow, thisNumberBuffer[ digitIdx ], otherNumberBuffer[ digitIdx ], thisNumberBuffer[ digitIdx ] );
 
     // Carry overflow:
     uint32_t digitIdx = otherNumberSize;
     while( overflow != 0 )
     {
-        TDigitType thisDigit = thisNumberBuffer[ digitIdx ];
-        TDigitType final = thisDigit - overflow;
-        overflow = thisDigit < overflow;
-        thisNumberBuffer[ digitIdx ] = final;
+        overflow = SubtructDigitsWithBorrow( overflow, thisNumberBuffer[ digitIdx ], 0, thisNumberBuffer[ digitIdx ] );
         ++digitIdx;
     }
 }
 
+namespace helpers
+{
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void MultiplyInplaceImpl( TConstRawBufferPtr thisNumberBuffer, const uint32_t thisNumberSize, TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize, TRawBufferPtr out_resultBuffer )
+static inline TDigitType MultiplyAddRow( const TDigitType thisDigit, TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize, TRawBufferPtr resultBuffer )
 {
-    uint16_t overflow = 0;
+    // Adds thisDigit * otherNumber to resultBuffer. Returns the most significant digit of the row.
+    TDigitType overflow = 0;
+    for( uint32_t otherDigitIdx = 0; otherDigitIdx < otherNumberSize; ++otherDigitIdx )
+    {
+        // thisDigit * otherDigit + resultDigit + overflow always fits into two digits.
+        TDigitType multHigh;
+        TDigitType multLow = MultiplyDigits( thisDigit, otherNumberBuffer[ otherDigitIdx ], multHigh );
+        multHigh += AddDigitsWithCarry( 0, multLow, resultBuffer[ otherDigitIdx ], multLow );
+        multHigh += AddDigitsWithCarry( 0, multLow, overflow, multLow );
+        resultBuffer[ otherDigitIdx ] = multLow;
+        overflow = multHigh;
+    }
 
+    return overflow;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline TDigitType MultiplySubtructRow( const TDigitType thisDigit, TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize, TRawBufferPtr resultBuffer )
+{
+    // Subtructs thisDigit * otherNumber from resultBuffer. Returns digit, that has to be subtructed from the next digit of the result.
+    TDigitType overflow = 0;
+    for( uint32_t otherDigitIdx = 0; otherDigitIdx < otherNumberSize; ++otherDigitIdx )
+    {
+        // thisDigit * otherDigit + overflow + borrow always fits into two digits.
+        TDigitType multHigh;
+        TDigitType multLow = MultiplyDigits( thisDigit, otherNumberBuffer[ otherDigitIdx ], multHigh );
+        multHigh += AddDigitsWithCarry( 0, multLow, overflow, multLow );
+        multHigh += SubtructDigitsWithBorrow( 0, resultBuffer[ otherDigitIdx ], multLow, resultBuffer[ otherDigitIdx ] );
+        overflow = multHigh;
+    }
+
+    return overflow;
+}
+
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void MultiplyInplaceImpl( TConstRawBufferPtr thisNumberBuffer, const uint32_t thisNumberSize, TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize, TRawBufferPtr out_resultBuffer )
+{
     for( uint32_t thisDigitIdx = 0; thisDigitIdx < thisNumberSize; ++thisDigitIdx )
     {
-        const uint8_t thisDigit = thisNumberBuffer[ thisDigitIdx ];
-        for( uint32_t otherDigitIdx = 0; otherDigitIdx < otherNumberSize; ++otherDigitIdx )
+        out_resultBuffer[ thisDigitIdx + otherNumberSize ] =
+            helpers::MultiplyAddRow( thisNumberBuffer[ thisDigitIdx ], otherNumberBuffer, otherNumberSize, &out_resultBuffer[ thisDigitIdx ] );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void SquareInplaceImpl( TConstRawBufferPtr numberBuffer, const uint32_t numberSize, TRawBufferPtr out_resultBuffer )
+{
+    // number^2 = sum( d[i]^2 * B^2i ) + 2 * sum( d[i] * d[j] * B^(i+j) ) for i < j,
+    // so every cross product is computed only once, which is ~half of the work of general multiplication.
+    for( uint32_t digitIdx = 0; digitIdx + 1 < numberSize; ++digitIdx )
+    {
+        out_resultBuffer[ digitIdx + numberSize ] =
+            helpers::MultiplyAddRow( numberBuffer[ digitIdx ], &numberBuffer[ digitIdx + 1 ], numberSize - digitIdx - 1, &out_resultBuffer[ 2 * digitIdx + 1 ] );
+    }
+
+    // Cross products sum is less then number^2 / 2, so doubling can not overflow.
+    ShiftLeftInplaceImpl( out_resultBuffer, 2 * numberSize, 1 );
+
+    uint8_t carry = 0;
+    for( uint32_t digitIdx = 0; digitIdx < numberSize; ++digitIdx )
+    {
+        TDigitType squareHigh;
+        const TDigitType squareLow = MultiplyDigits( numberBuffer[ digitIdx ], numberBuffer[ digitIdx ], squareHigh );
+        carry = AddDigitsWithCarry( carry, out_resultBuffer[ 2 * digitIdx ], squareLow, out_resultBuffer[ 2 * digitIdx ] );
+        carry = AddDigitsWithCarry( carry, out_resultBuffer[ 2 * digitIdx + 1 ], squareHigh, out_resultBuffer[ 2 * digitIdx + 1 ] );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TDigitType AddDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType digit )
+{
+    uint8_t carry = AddDigitsWithCarry( 0, numberBuffer[ 0 ], digit, numberBuffer[ 0 ] );
+    for( uint32_t digitIdx = 1; carry != 0 && digitIdx < numberSize; ++digitIdx )
+        carry = AddDigitsWithCarry( carry, numberBuffer[ digitIdx ], 0, numberBuffer[ digitIdx ] );
+
+    return carry;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void SubtructDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType digit )
+{
+    uint8_t borrow = SubtructDigitsWithBorrow( 0, numberBuffer[ 0 ], digit, numberBuffer[ 0 ] );
+    for( uint32_t digitIdx = 1; borrow != 0 && digitIdx < numberSize; ++digitIdx )
+        borrow = SubtructDigitsWithBorrow( borrow, numberBuffer[ digitIdx ], 0, numberBuffer[ digitIdx ] );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TDigitType MultiplyByDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType digit )
+{
+    TDigitType overflow = 0;
+    for( uint32_t digitIdx = 0; digitIdx < numberSize; ++digitIdx )
+    {
+        TDigitType multHigh;
+        TDigitType multLow = MultiplyDigits( numberBuffer[ digitIdx ], digit, multHigh );
+        multHigh += AddDigitsWithCarry( 0, multLow, overflow, multLow );
+        numberBuffer[ digitIdx ] = multLow;
+        overflow = multHigh;
+    }
+
+    return overflow;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TDigitType DivideByDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType divisor )
+{
+    // Divisor is normalized, so the hardware division can be replaced by multiplications with its reciprocal.
+    // The number is shifted by the same amount on the fly, which leaves quotient unchanged and scales the remainder.
+    const uint32_t normalizationShift = CountLeadingZeros( divisor );
+    const TDigitType normalizedDivisor = divisor << normalizationShift;
+    const TDigitType reciprocal = CalcDigitReciprocal( normalizedDivisor );
+
+    TDigitType remainder = 0;
+    for( uint32_t digitIdx = numberSize; digitIdx > 0; --digitIdx )
+    {
+        const TDigitType digit = numberBuffer[ digitIdx - 1 ];
+        const TDigitType high = normalizationShift == 0 ? remainder : remainder | ( digit >> ( DIGIT_BITS - normalizationShift ) );
+        numberBuffer[ digitIdx - 1 ] = DivideDigitsWithReciprocal( high, digit << normalizationShift, normalizedDivisor, reciprocal, remainder );
+    }
+
+    return remainder >> normalizationShift;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void DivideInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, TConstRawBufferPtr divisorBuffer, const uint32_t divisorSize, TRawBufferPtr out_quotientBuffer )
+{
+    // Knuth's algorithm D ( TAOCP vol. 2, 4.3.1 ):
+    // Every quotient digit is estimated by dividing top two digits of the current remainder by the top digit of the divisor.
+    // Since the divisor is normalized, the estimate is at most two too big. Check with the second digit of the divisor
+    // makes it at most one too big, which is fixed by adding the divisor back after the multiply and subtruct step.
+    const TDigitType divisorHigh = divisorBuffer[ divisorSize - 1 ];
+    const TDigitType divisorLow = divisorBuffer[ divisorSize - 2 ];
+    const TDigitType reciprocal = CalcDigitReciprocal( divisorHigh );
+
+    for( uint32_t quotientIdx = numberSize - divisorSize; quotientIdx > 0; --quotientIdx )
+    {
+        // Current remainder has divisorSize + 1 digits and is less then divisor * B.
+        TRawBufferPtr remainderBuffer = numberBuffer + quotientIdx - 1;
+        const TDigitType remainderHigh = remainderBuffer[ divisorSize ];
+
+        TDigitType quotientDigit = BASE_MINUS_ONE;
+        TDigitType partialRemainder = 0;
+        bool isPartialRemainderOverflow = false;
+        if( remainderHigh < divisorHigh )
+            quotientDigit = DivideDigitsWithReciprocal( remainderHigh, remainderBuffer[ divisorSize - 1 ], divisorHigh, reciprocal, partialRemainder );
+        else
+            isPartialRemainderOverflow = AddDigitsWithCarry( 0, remainderBuffer[ divisorSize - 1 ], divisorHigh, partialRemainder ) != 0;
+
+        if( !isPartialRemainderOverflow )
         {
-            uint16_t mult = ( uint16_t )thisDigit * ( uint16_t )otherNumberBuffer[ otherDigitIdx ];
-            overflow += mult + ( uint16_t )out_resultBuffer[ thisDigitIdx + otherDigitIdx ];
-            out_resultBuffer[ thisDigitIdx + otherDigitIdx ] = ( TDigitType )overflow;
-            overflow = overflow >> 8;
+            // While quotientDigit * divisorLow > partialRemainder * B + third digit of the remainder:
+            TDigitType productHigh;
+            TDigitType productLow = MultiplyDigits( quotientDigit, divisorLow, productHigh );
+            while( productHigh > partialRemainder || ( productHigh == partialRemainder && productLow > remainderBuffer[ divisorSize - 2 ] ) )
+            {
+                --quotientDigit;
+                productHigh -= SubtructDigitsWithBorrow( 0, productLow, divisorLow, productLow );
+                if( AddDigitsWithCarry( 0, partialRemainder, divisorHigh, partialRemainder ) != 0 )
+                    break;
+            }
         }
 
-        out_resultBuffer[ thisDigitIdx + otherNumberSize ] += ( TDigitType )overflow;
-        overflow = overflow >> 8;
+        const TDigitType borrow = helpers::MultiplySubtructRow( quotientDigit, divisorBuffer, divisorSize, remainderBuffer );
+        if( borrow > remainderHigh )
+        {
+            // Estimate was one too big, so the result is negative.
+            --quotientDigit;
+            uint8_t carry = 0;
+            for( uint32_t digitIdx = 0; digitIdx < divisorSize; ++digitIdx )
+                carry = AddDigitsWithCarry( carry, remainderBuffer[ digitIdx ], divisorBuffer[ digitIdx ], remainderBuffer[ digitIdx ] );
+        }
+
+        // New remainder is less then divisor, so its top digit is always zero.
+        remainderBuffer[ divisorSize ] = 0;
+        out_quotientBuffer[ quotientIdx - 1 ] = quotientDigit;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TDigitType MontgomeryReduceInplaceImpl( TRawBufferPtr numberBuffer, TConstRawBufferPtr modulusBuffer, const uint32_t modulusSize, const TDigitType modulusInverse )
+{
+    // Separated operand scanning: every digit from the lowest one is zeroed by adding its multiple of the modulus,
+    // so after modulusSize rows the number is divisible by B^modulusSize. Carries out of the top digit of the row
+    // are kept aside and added to the top digit of the next row.
+    uint8_t carry = 0;
+    for( uint32_t digitIdx = 0; digitIdx < modulusSize; ++digitIdx )
+    {
+        const TDigitType multiplier = numberBuffer[ digitIdx ] * modulusInverse;
+        const TDigitType overflow = helpers::MultiplyAddRow( multiplier, modulusBuffer, modulusSize, &numberBuffer[ digitIdx ] );
+        carry = AddDigitsWithCarry( carry, numberBuffer[ digitIdx + modulusSize ], overflow, numberBuffer[ digitIdx + modulusSize ] );
+    }
+
+    return carry;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TDigitType ShiftLeftInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const uint32_t bitsShift )
+{
+    if( bitsShift == 0 || numberSize == 0 )
+        return 0;
+
+    const TDigitType shiftedOut = numberBuffer[ numberSize - 1 ] >> ( DIGIT_BITS - bitsShift );
+    for( uint32_t digitIdx = numberSize - 1; digitIdx > 0; --digitIdx )
+        numberBuffer[ digitIdx ] = ( numberBuffer[ digitIdx ] << bitsShift ) | ( numberBuffer[ digitIdx - 1 ] >> ( DIGIT_BITS - bitsShift ) );
+
+    numberBuffer[ 0 ] <<= bitsShift;
+    return shiftedOut;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void ShiftRightInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const uint32_t bitsShift )
+{
+    if( bitsShift == 0 || numberSize == 0 )
+        return;
+
+    for( uint32_t digitIdx = 0; digitIdx + 1 < numberSize; ++digitIdx )
+        numberBuffer[ digitIdx ] = ( numberBuffer[ digitIdx ] >> bitsShift ) | ( numberBuffer[ digitIdx + 1 ] << ( DIGIT_BITS - bitsShift ) );
+
+    numberBuffer[ numberSize - 1 ] >>= bitsShift;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool IsDecimalStringImpl( const char* string, const size_t stringSize )
+{
+    for( size_t charIdx = 0; charIdx < stringSize; ++charIdx )
+    {
+        if( string[ charIdx ] < '0' || string[ charIdx ] > '9' )
+            return false;
     }
+
+    return true;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void ReadDecimalChunksImpl( const char* digits, const uint32_t numberOfChunks, TRawBufferPtr out_chunks )
+{
+    for( uint32_t chunkIdx = 0; chunkIdx < numberOfChunks; ++chunkIdx )
+    {
+        const char* chunkDigits = digits + ( size_t )chunkIdx * DECIMAL_CHUNK_DIGITS;
+        TDigitType chunk = 0;
+        for( uint32_t digitIdx = 0; digitIdx < DECIMAL_CHUNK_DIGITS; ++digitIdx )
+            chunk = chunk * 10 + ( TDigitType )( chunkDigits[ digitIdx ] - '0' );
+
+        out_chunks[ chunkIdx ] = chunk;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void WriteDecimalChunksImpl( TConstRawBufferPtr chunks, const uint32_t numberOfChunks, char* out_digits )
+{
+    for( uint32_t chunkIdx = 0; chunkIdx < numberOfChunks; ++chunkIdx )
+    {
+        char* chunkDigits = out_digits + ( size_t )chunkIdx * DECIMAL_CHUNK_DIGITS;
+        TDigitType chunk = chunks[ chunkIdx ];
+        for( uint32_t digitIdx = DECIMAL_CHUNK_DIGITS; digitIdx > 0; --digitIdx )
+        {
+            chunkDigits[ digitIdx - 1 ] = ( char )( '0' + chunk % 10 );
+            chunk /= 10;
+        }
+    }
+}
+
+}
 }
 }
-}
\ No newline at end of file
@@ -16,8 +16,20 @@ void MultiplyInplaceImpl(
     TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize,
     TRawBufferPtr out_resultBuffer
 );
+void SquareInplaceImpl( TConstRawBufferPtr numberBuffer, const uint32_t numberSize, TRawBufferPtr out_resultBuffer );
+TDigitType AddDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType digit );
+void SubtructDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType digit );
+TDigitType MultiplyByDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType digit );
+TDigitType DivideByDigitInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const TDigitType divisor );
+void DivideInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, TConstRawBufferPtr divisorBuffer, const uint32_t divisorSize, TRawBufferPtr out_quotientBuffer );
+TDigitType MontgomeryReduceInplaceImpl( TRawBufferPtr numberBuffer, TConstRawBufferPtr modulusBuffer, const uint32_t modulusSize, const TDigitType modulusInverse );
+TDigitType ShiftLeftInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const uint32_t bitsShift );
+void ShiftRightInplaceImpl( TRawBufferPtr numberBuffer, const uint32_t numberSize, const uint32_t bitsShift );
+bool IsDecimalStringImpl( const char* string, const size_t stringSize );
+void ReadDecimalChunksImpl( const char* digits, const uint32_t numberOfChunks, TRawBufferPtr out_chunks );
+void WriteDecimalChunksImpl( TConstRawBufferPtr chunks, const uint32_t numberOfChunks, char* out_digits );
 // -----------------------------------------
 
 }
 }
-}
\ No newline at end of file
+}
@@ -51,6 +51,26 @@ static inline __m128i transformToClassOp( const __m128i thisNumber, const __m128
     return  _mm_or_si128( carryVec, maybeVec );
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline __m128i transformToBorrowClassOp( const __m128i thisNumber, const __m128i otherNumber )
+{
+    // Same classes are used for subtraction:
+    // N - not borrow, B - borrow ( encoded as C ), M - maybe borrow.
+    const __m128i MAYBE_FLAG = _mm_set1_epi8( 2 );
+    const __m128i BORROW_FLAG = _mm_set1_epi8( 1 );
+
+    // Calc MAYBE op.
+    __m128i maybeVec = _mm_cmpeq_epi8( thisNumber, otherNumber );
+    maybeVec = _mm_and_si128( maybeVec, MAYBE_FLAG );
+
+    // Calc BORROW op.
+    __m128i borrowVec = _mm_cmpge_epu8( thisNumber, otherNumber );
+    borrowVec = _mm_andnot_si128( borrowVec, BORROW_FLAG );
+
+    // Merge results, as NOT BORROW op is 0.
+    return  _mm_or_si128( borrowVec, maybeVec );
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////
 static inline __m128i prefixSumOfClassOp( __m128i classOpVec, int& in_out_prevCarry )
 {
@@ -104,35 +124,185 @@ static inline __m128i prefixSumOfClassOp( __m128i classOpVec, int& in_out_prevCa
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void AddInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize )
 {
+    // [NOTE]: Kernel operates on bytes. Since digits are stored in little endian, adding numbers byte by byte
+    // gives exactly the same result as adding them digit by digit.
+    uint8_t* const thisNumberBytes = ( uint8_t* )thisNumberBuffer;
+    const uint8_t* const otherNumberBytes = ( const uint8_t* )otherNumberBuffer;
+    const uint32_t otherNumberBytesSize = otherNumberSize * sizeof( TDigitType );
+
     int carry = 0;
-    uint32_t digitIdx = 0;
-    for( ; digitIdx < otherNumberSize; digitIdx += SIMD_SIZE )
+    uint32_t byteIdx = 0;
+    for( ; byteIdx < otherNumberBytesSize; byteIdx += SIMD_SIZE )
     {
-        const __m128i thisNumberBufferVec = _mm_load_si128( ( __m128i* const )&thisNumberBuffer[ digitIdx ] );
-        const __m128i otherNumberBufferVec = _mm_load_si128( ( __m128i* const )&otherNumberBuffer[ digitIdx ] );
+        const __m128i thisNumberBufferVec = _mm_load_si128( ( const __m128i* )&thisNumberBytes[ byteIdx ] );
+        const __m128i otherNumberBufferVec = _mm_load_si128( ( const __m128i* )&otherNumberBytes[ byteIdx ] );
 
         __m128i classOpVec = transformToClassOp( thisNumberBufferVec, otherNumberBufferVec );
         __m128i overflowVec = prefixSumOfClassOp( classOpVec, carry );
         __m128i addResult = _mm_add_epi8( thisNumberBufferVec, otherNumberBufferVec );
         addResult = _mm_add_epi8( addResult, overflowVec );
-        _mm_store_si128( ( __m128i* )&thisNumberBuffer[ digitIdx ], addResult );
+        _mm_store_si128( ( __m128i* )&thisNumberBytes[ byteIdx ], addResult );
     }
 
     const __m128i ZERO = _mm_set1_epi8( 0 );
 
     while( carry != 0 )
     {
-        const __m128i thisNumberBufferVec = _mm_load_si128( ( __m128i* const )&thisNumberBuffer[ digitIdx ] );
+        const __m128i thisNumberBufferVec = _mm_load_si128( ( const __m128i* )&thisNumberBytes[ byteIdx ] );
 
         __m128i classOpVec = transformToClassOp( thisNumberBufferVec, ZERO );
         __m128i overflowVec = prefixSumOfClassOp( classOpVec, carry );
         __m128i addResult = _mm_add_epi8( thisNumberBufferVec, overflowVec );
-        _mm_store_si128( ( __m128i* )&thisNumberBuffer[ digitIdx ], addResult );
+        _mm_store_si128( ( __m128i* )&thisNumberBytes[ byteIdx ], addResult );
+
+        byteIdx += SIMD_SIZE;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void SustructInplaceImpl( TRawBufferPtr thisNumberBuffer, const TConstRawBufferPtr otherNumberBuffer, const uint32_t otherNumberSize )
+{
+    // [NOTE]: Kernel operates on bytes. Since digits are stored in little endian, subtracting numbers byte by byte
+    // gives exactly the same result as subtracting them digit by digit.
+    uint8_t* const thisNumberBytes = ( uint8_t* )thisNumberBuffer;
+    const uint8_t* const otherNumberBytes = ( const uint8_t* )otherNumberBuffer;
+    const uint32_t otherNumberBytesSize = otherNumberSize * sizeof( TDigitType );
+
+    int borrow = 0;
+    uint32_t byteIdx = 0;
+    for( ; byteIdx < otherNumberBytesSize; byteIdx += SIMD_SIZE )
+    {
+        const __m128i thisNumberBufferVec = _mm_load_si128( ( const __m128i* )&thisNumberBytes[ byteIdx ] );
+        const __m128i otherNumberBufferVec = _mm_load_si128( ( const __m128i* )&otherNumberBytes[ byteIdx ] );
+
+        __m128i classOpVec = transformToBorrowClassOp( thisNumberBufferVec, otherNumberBufferVec );
+        __m128i borrowVec = prefixSumOfClassOp( classOpVec, borrow );
+        __m128i subResult = _mm_sub_epi8( thisNumberBufferVec, otherNumberBufferVec );
+        subResult = _mm_sub_epi8( subResult, borrowVec );
+        _mm_store_si128( ( __m128i* )&thisNumberBytes[ byteIdx ], subResult );
+    }
+
+    const __m128i ZERO = _mm_set1_epi8( 0 );
+
+    while( borrow != 0 )
+    {
+        const __m128i thisNumberBufferVec = _mm_load_si128( ( const __m128i* )&thisNumberBytes[ byteIdx ] );
+
+        __m128i classOpVec = transformToBorrowClassOp( thisNumberBufferVec, ZERO );
+        __m128i borrowVec = prefixSumOfClassOp( classOpVec, borrow );
+        __m128i subResult = _mm_sub_epi8( thisNumberBufferVec, borrowVec );
+        _mm_store_si128( ( __m128i* )&thisNumberBytes[ byteIdx ], subResult );
+
+        byteIdx += SIMD_SIZE;
+    }
+}
+
+////////////////
+// Decimal kernels work on ASCII digits:
+// - parsing multiplies digits by 10 and adds them in pairs ( pmaddubsw ), then the pairs by 100 and the quadruples by 10000
+//   ( pmaddwd ), which gives two numbers of 8 digits per vector.
+// - formatting splits numbers of 8 digits into quadruples, and computes prefixes a, ab, abc, abcd of every quadruple abcd
+//   by multiplication with fixed point reciprocals of 1000, 100, 10 and 1. Every digit is its prefix minus 10 times the previous one.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline uint64_t parse16Digits( const char* digits )
+{
+    const __m128i ASCII_ZERO = _mm_set1_epi8( '0' );
+    const __m128i PAIR_MULTIPLIERS = _mm_setr_epi8( 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1 );
+    const __m128i QUADRUPLE_MULTIPLIERS = _mm_setr_epi16( 100, 1, 100, 1, 100, 1, 100, 1 );
+    const __m128i OCTUPLE_MULTIPLIERS = _mm_setr_epi16( 10000, 1, 10000, 1, 10000, 1, 10000, 1 );
+
+    const __m128i digitsVec = _mm_sub_epi8( _mm_loadu_si128( ( const __m128i* )digits ), ASCII_ZERO );
+    const __m128i pairs = _mm_maddubs_epi16( digitsVec, PAIR_MULTIPLIERS );
+    const __m128i quadruples = _mm_madd_epi16( pairs, QUADRUPLE_MULTIPLIERS );
+    const __m128i octuples = _mm_madd_epi16( _mm_packus_epi32( quadruples, quadruples ), OCTUPLE_MULTIPLIERS );
 
-        digitIdx += SIMD_SIZE;
+    return ( uint64_t )( uint32_t )_mm_cvtsi128_si32( octuples ) * 100000000 + ( uint32_t )_mm_extract_epi32( octuples, 1 );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline __m128i quadrupleDigits( const __m128i quadruples )
+{
+    // Quadruples are multiplied by 4 and copied to 4 words, what gives digits of 2 quadruples.
+    const __m128i RECIPROCALS = _mm_setr_epi16( 8389, 5243, 13108, ( short )32768, 8389, 5243, 13108, ( short )32768 );
+    const __m128i SHIFTS = _mm_setr_epi16( 1 << 7, 1 << 11, 1 << 13, ( short )( 1 << 15 ), 1 << 7, 1 << 11, 1 << 13, ( short )( 1 << 15 ) );
+
+    const __m128i prefixes = _mm_mulhi_epu16( _mm_mulhi_epu16( quadruples, RECIPROCALS ), SHIFTS );
+    const __m128i previousPrefixes = _mm_slli_epi64( _mm_mullo_epi16( prefixes, _mm_set1_epi16( 10 ) ), 16 );
+    return _mm_sub_epi16( prefixes, previousPrefixes );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline __m128i format16Digits( const __m128i octuples )
+{
+    // Octuples are stored in 64 bit lanes. x / 10000 = ( x * 0xD1B71759 ) >> 45 for x < 10^8.
+    const __m128i DIVIDE_BY_10000 = _mm_set1_epi32( ( int )0xD1B71759 );
+    const __m128i FIRST_QUADRUPLES = _mm_setr_epi8( 0, 1, 0, 1, 0, 1, 0, 1, 2, 3, 2, 3, 2, 3, 2, 3 );
+    const __m128i SECOND_QUADRUPLES = _mm_setr_epi8( 8, 9, 8, 9, 8, 9, 8, 9, 10, 11, 10, 11, 10, 11, 10, 11 );
+
+    const __m128i highQuadruples = _mm_srli_epi64( _mm_mul_epu32( octuples, DIVIDE_BY_10000 ), 45 );
+    const __m128i lowQuadruples = _mm_sub_epi32( octuples, _mm_mul_epu32( highQuadruples, _mm_set1_epi32( 10000 ) ) );
+    const __m128i quadruples = _mm_slli_epi16( _mm_or_si128( highQuadruples, _mm_slli_epi64( lowQuadruples, 16 ) ), 2 );
+
+    const __m128i firstDigits = quadrupleDigits( _mm_shuffle_epi8( quadruples, FIRST_QUADRUPLES ) );
+    const __m128i secondDigits = quadrupleDigits( _mm_shuffle_epi8( quadruples, SECOND_QUADRUPLES ) );
+    return _mm_add_epi8( _mm_packus_epi16( firstDigits, secondDigits ), _mm_set1_epi8( '0' ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool IsDecimalStringImpl( const char* string, const size_t stringSize )
+{
+    const __m128i ASCII_ZERO = _mm_set1_epi8( '0' );
+    const __m128i NINE = _mm_set1_epi8( 9 );
+
+    // Characters below '0' wrap around to big unsigned values.
+    size_t charIdx = 0;
+    for( ; charIdx + SIMD_SIZE <= stringSize; charIdx += SIMD_SIZE )
+    {
+        const __m128i values = _mm_sub_epi8( _mm_loadu_si128( ( const __m128i* )&string[ charIdx ] ), ASCII_ZERO );
+        if( _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_max_epu8( values, NINE ), NINE ) ) != 0xFFFF )
+            return false;
+    }
+
+    for( ; charIdx < stringSize; ++charIdx )
+    {
+        if( string[ charIdx ] < '0' || string[ charIdx ] > '9' )
+            return false;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+void ReadDecimalChunksImpl( const char* digits, const uint32_t numberOfChunks, TRawBufferPtr out_chunks )
+{
+    // Chunk has 3 digits more then a vector, they are parsed separately.
+    for( uint32_t chunkIdx = 0; chunkIdx < numberOfChunks; ++chunkIdx )
+    {
+        const char* chunkDigits = digits + ( size_t )chunkIdx * DECIMAL_CHUNK_DIGITS;
+        const uint64_t topDigits = ( uint64_t )( chunkDigits[ 0 ] - '0' ) * 100 + ( uint64_t )( chunkDigits[ 1 ] - '0' ) * 10 + ( uint64_t )( chunkDigits[ 2 ] - '0' );
+        out_chunks[ chunkIdx ] = topDigits * 10000000000000000ull + parse16Digits( chunkDigits + 3 );
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+void WriteDecimalChunksImpl( TConstRawBufferPtr chunks, const uint32_t numberOfChunks, char* out_digits )
+{
+    for( uint32_t chunkIdx = 0; chunkIdx < numberOfChunks; ++chunkIdx )
+    {
+        char* chunkDigits = out_digits + ( size_t )chunkIdx * DECIMAL_CHUNK_DIGITS;
+        const uint64_t chunk = chunks[ chunkIdx ];
+        const uint32_t topDigits = ( uint32_t )( chunk / 10000000000000000ull );
+        const uint64_t lowDigits = chunk % 10000000000000000ull;
+
+        chunkDigits[ 0 ] = ( char )( '0' + topDigits / 100 );
+        chunkDigits[ 1 ] = ( char )( '0' + topDigits / 10 % 10 );
+        chunkDigits[ 2 ] = ( char )( '0' + topDigits % 10 );
+        const __m128i octuples = _mm_set_epi64x( ( long long )( lowDigits % 100000000 ), ( long long )( lowDigits / 100000000 ) );
+        _mm_storeu_si128( ( __m128i* )( chunkDigits + 3 ), format16Digits( octuples ) );
+    }
+}
+
+}
 }
 }
-}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 
 namespace sbn
@@ -6,10 +7,16 @@ namespace sbn
 namespace internal
 {
 
-typedef uint8_t TDigitType;
+typedef uint64_t TDigitType;
 typedef TDigitType* TRawBufferPtr;
 typedef const TDigitType* TConstRawBufferPtr;
-constexpr TDigitType BASE_MINUS_ONE = 255;
+constexpr TDigitType BASE_MINUS_ONE = 0xFFFFFFFFFFFFFFFF;
+constexpr uint32_t DIGIT_BITS = 64;
+constexpr uint32_t DIGIT_BYTES = 8;
 
+// Decimal chunk is a group of DECIMAL_CHUNK_DIGITS decimal digits stored in a single digit.
+constexpr uint32_t DECIMAL_CHUNK_DIGITS = 19;
+constexpr TDigitType DECIMAL_CHUNK_BASE = 10000000000000000000ull;
+
+}
 }
-}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "../include/barrettReducer.h"
+#include <cstring>
+#include <utility>
+#include "arithmeticImpl/typedefs.h"
+#include "reciprocalEstimator/reciprocalEstimator.h"
+
+namespace sbn
+{
+namespace helpers
+{
+
+// Divisors shorter then threshold ( in limbs ) are divided using schoolbook long division, which is faster then two multiplications.
+constexpr static uint32_t BARRETT_THRESHOLD = 80;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+BarrettReducer::BarrettReducer( const SimpleBigNum& divisor )
+    : m_divisor( divisor )
+{
+    if( m_divisor.GetNumberOfLimbs() >= helpers::BARRETT_THRESHOLD )
+        m_reciprocal = internal::ReciprocalEstimator::Estimate( m_divisor, 2 * m_divisor.GetNumberOfLimbs() * internal::DIGIT_BYTES );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const SimpleBigNum& BarrettReducer::GetDivisor() const
+{
+    return m_divisor;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void BarrettReducer::DivMod( const SimpleBigNum& number, SimpleBigNum& out_quotient, SimpleBigNum& out_remainder ) const
+{
+    const uint32_t divisorSize = m_divisor.GetNumberOfLimbs();
+    const uint32_t numberSize = number.GetNumberOfLimbs();
+
+    // Single limb divisors are divided exactly by the single digit kernel.
+    if( divisorSize == 1 )
+    {
+        SimpleBigNum quotient = number;
+        const uint64_t remainder = quotient.DivMod( m_divisor.m_numberLittleEndian.Front() );
+        out_quotient = std::move( quotient );
+        out_remainder = SimpleBigNum( remainder );
+        return;
+    }
+
+    if( numberSize <= 2 * divisorSize )
+    {
+        SimpleBigNum quotient;
+        SimpleBigNum remainder;
+        DivModStep( number, quotient, remainder );
+        out_quotient = std::move( quotient );
+        out_remainder = std::move( remainder );
+        return;
+    }
+
+    // Longer numbers are divided block by block, starting from the most significant one:
+    // remainder * B^n + block is less then divisor * B^n, so it fits into a single step.
+    const uint32_t numberOfBlocks = ( numberSize + divisorSize - 1 ) / divisorSize;
+    std::vector< SimpleBigNum > blocks( numberOfBlocks );
+    number.SplitIntoParts( divisorSize, numberOfBlocks, blocks.data() );
+
+    SimpleBigNum::TLimbs quotient( SimpleBigNum::GetAllocator() );
+    quotient.Resize( numberOfBlocks * divisorSize );
+    SimpleBigNum remainder;
+    for( uint32_t blockIdx = numberOfBlocks; blockIdx > 0; --blockIdx )
+    {
+        SimpleBigNum current = remainder;
+        if( !current.IsZero() )
+            current.ShiftLeftLimbs( divisorSize );
+        current.Add( blocks[ blockIdx - 1 ] );
+
+        SimpleBigNum blockQuotient;
+        DivModStep( current, blockQuotient, remainder );
+        memcpy( quotient.Data() + ( blockIdx - 1 ) * divisorSize, blockQuotient.m_numberLittleEndian.Data(), blockQuotient.GetNumberOfLimbs() * sizeof( uint64_t ) );
+    }
+
+    std::swap( out_quotient.m_numberLittleEndian, quotient );
+    out_quotient.RemoveLeadingZeros();
+    out_remainder = std::move( remainder );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void BarrettReducer::Divide( SimpleBigNum& number ) const
+{
+    SimpleBigNum remainder;
+    DivMod( number, number, remainder );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void BarrettReducer::Mod( SimpleBigNum& number ) const
+{
+    SimpleBigNum quotient;
+    DivMod( number, quotient, number );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void BarrettReducer::DivModStep( const SimpleBigNum& number, SimpleBigNum& out_quotient, SimpleBigNum& out_remainder ) const
+{
+    // Barrett reduction:
+    // q = ( ( number / B^(n-1) ) * floor( B^(2n) / divisor ) ) / B^(n+1)
+    // Both truncations make q at most 2 less then the real quotient, what is fixed using the remainder.
+    const uint32_t divisorSize = m_divisor.GetNumberOfLimbs();
+    if( divisorSize < helpers::BARRETT_THRESHOLD )
+    {
+        number.DivMod( m_divisor, out_quotient, out_remainder );
+        return;
+    }
+
+    if( number.IsLessThen( m_divisor ) )
+    {
+        out_quotient.SetZero();
+        out_remainder = number;
+        return;
+    }
+
+    out_quotient = number;
+    out_quotient.ShiftRightLimbs( divisorSize - 1 );
+    out_quotient.Multiply( m_reciprocal );
+    out_quotient.ShiftRightLimbs( divisorSize + 1 );
+
+    SimpleBigNum product = out_quotient;
+    product.Multiply( m_divisor );
+    out_remainder = number;
+    out_remainder.Subtruct( product );
+    while( out_remainder.IsGreaterOrEqualTo( m_divisor ) )
+    {
+        out_remainder.Subtruct( m_divisor );
+        out_quotient.Add( 1 );
+    }
+}
+
+}
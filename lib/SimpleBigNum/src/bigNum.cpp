@@ -1,146 +1,1085 @@
 #include "../include/bigNum.h"
 #include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
 #include "arithmeticImpl/arithmeticImpl.h"
+#include "arithmeticImpl/digitOps.h"
+#include "tools/allocator/alignedAllocator/alignedAllocator.h"
 #include "reciprocalEstimator/reciprocalEstimator.h"
+#include "karatsubaMultiplier/karatsubaMultiplier.h"
+#include "nttMultiplier/nttMultiplier.h"
+#include "modularMultiplier/modularMultiplier.h"
+#include "gcdCalculator/gcdCalculator.h"
+#include "decimalConverter/decimalConverter.h"
+#include "radixConverter/radixConverter.h"
 
 namespace sbn
 {
 namespace helpers
 {
 
-constexpr static uint32_t KARATSUBA_THRESHOLD = 150;
+// Thresholds expressed in limbs. Karatsuba threshold is compared with the bigger number,
+// Toom thresholds with the smaller one, so both numbers have to be long enough to be split into 3 or 4 parts.
+constexpr static uint32_t KARATSUBA_THRESHOLD = internal::KaratsubaMultiplier::MULTIPLY_THRESHOLD;
+// Burnikel-Ziegler division threshold is compared with the divisor and with the quotient, recursion splits
+// the divisor into halves down to that size. Newton division threshold is compared with the divisor.
+constexpr static uint32_t BURNIKEL_ZIEGLER_THRESHOLD = 80;
+constexpr static uint32_t NEWTON_DIVISION_THRESHOLD = 20000;
+constexpr static uint32_t TOOM3_THRESHOLD = 150;
+constexpr static uint32_t TOOM4_THRESHOLD = 400;
+constexpr static uint32_t NTT_THRESHOLD = 1600;
+// Basecase squaring is cheaper then basecase multiplication, so it pays off longer.
+constexpr static uint32_t KARATSUBA_SQUARE_THRESHOLD = internal::KaratsubaMultiplier::SQUARE_THRESHOLD;
+constexpr static uint32_t TOOM3_SQUARE_THRESHOLD = 150;
+constexpr static uint32_t TOOM4_SQUARE_THRESHOLD = 400;
+constexpr static uint32_t NTT_SQUARE_THRESHOLD = 1600;
+// Numbers are multiplied chunk by chunk when the bigger one is at least that many times longer then the smaller one.
+constexpr static uint32_t UNBALANCED_RATIO = 2;
 
-// Helper uninon for converting number binary number to number base 256.
-union BigNumUnion_u64
+static_assert( BURNIKEL_ZIEGLER_THRESHOLD >= 4, "Recursive division needs at least two limbs in every half of the divisor." );
+
+// Number with sign. Toom-Cook evaluation and interpolation go through negative values.
+struct SignedNumber
 {
-    uint64_t m_uint64_t;
-    uint8_t m_uint8_t[ 8 ];
+    SimpleBigNum m_magnitude;
+    bool m_isNegative = false;
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint32_t GetSlidingWindowSize( uint32_t exponentBits )
+{
+    // Window of k bits needs 2^(k-1) precomputed odd powers and saves about exponentBits / ( k + 1 ) multiplications.
+    constexpr uint32_t WINDOW_SIZE_LIMITS[] = { 8, 24, 80, 240, 672, 1792 };
+
+    uint32_t windowSize = 1;
+    for( const uint32_t limit : WINDOW_SIZE_LIMITS )
+    {
+        if( exponentBits < limit )
+            break;
+
+        ++windowSize;
+    }
+
+    return windowSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint64_t RootDigit( uint64_t digit, uint32_t n )
+{
+    // Bits of the root are set from the most significant one, whenever the power does not exceed the digit.
+    uint64_t root = 0;
+    for( uint32_t bit = ( internal::DIGIT_BITS + n - 1 ) / n; bit > 0; --bit )
+    {
+        const uint64_t candidate = root | ( ( uint64_t )1 << ( bit - 1 ) );
+        uint64_t power = 1;
+        bool isTooBig = false;
+        for( uint32_t i = 0; i < n && !isTooBig; ++i )
+        {
+            isTooBig = power > digit / candidate;
+            power *= candidate;
+        }
+
+        if( !isTooBig )
+            root = candidate;
+    }
+
+    return root;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void AddSigned( SignedNumber& number, const SimpleBigNum& magnitude, bool isNegative )
+{
+    if( number.m_isNegative == isNegative )
+    {
+        number.m_magnitude.Add( magnitude );
+    }
+    else if( number.m_magnitude.IsGreaterOrEqualTo( magnitude ) )
+    {
+        number.m_magnitude.Subtruct( magnitude );
+    }
+    else
+    {
+        SimpleBigNum difference = magnitude;
+        difference.Subtruct( number.m_magnitude );
+        number.m_magnitude = std::move( difference );
+        number.m_isNegative = isNegative;
+    }
+
+    if( number.m_magnitude.IsZero() )
+        number.m_isNegative = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void AddSigned( SignedNumber& number, const SignedNumber& other )
+{
+    AddSigned( number, other.m_magnitude, other.m_isNegative );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void SubtructSigned( SignedNumber& number, const SignedNumber& other )
+{
+    AddSigned( number, other.m_magnitude, !other.m_isNegative );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void SubtructScaled( SignedNumber& number, const SimpleBigNum& magnitude, bool isNegative, uint64_t factor )
+{
+    // number -= factor * ( isNegative ? -magnitude : magnitude )
+    SimpleBigNum scaled = magnitude;
+    scaled.Multiply( factor );
+    AddSigned( number, scaled, !isNegative );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void SubtructSigned( SignedNumber& number, const SignedNumber& other, uint64_t factor )
+{
+    SubtructScaled( number, other.m_magnitude, other.m_isNegative, factor );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void SubtructSigned( SignedNumber& number, const SimpleBigNum& other, uint64_t factor )
+{
+    SubtructScaled( number, other, false, factor );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void DivideSignedExact( SignedNumber& number, uint64_t divisor )
+{
+    // Interpolation divides only values, that are known to be multiples of divisor.
+    number.m_magnitude.DivMod( divisor );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void MultiplySigned( SignedNumber& number, const SignedNumber& other, bool isSquare )
+{
+    if( isSquare )
+    {
+        number.m_magnitude.Square();
+        number.m_isNegative = false;
+        return;
+    }
+
+    number.m_magnitude.Multiply( other.m_magnitude );
+    number.m_isNegative = number.m_isNegative != other.m_isNegative && !number.m_magnitude.IsZero();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void EvaluateToom3( const SimpleBigNum* parts, SignedNumber* out_values )
+{
+    // Evaluates parts[ 2 ]*x^2 + parts[ 1 ]*x + parts[ 0 ] in points 0, 1, -1, 2 and infinity.
+    out_values[ 0 ].m_magnitude = parts[ 0 ];
+
+    SimpleBigNum evenSum = parts[ 0 ];
+    evenSum.Add( parts[ 2 ] );
+    out_values[ 1 ].m_magnitude = evenSum;
+    out_values[ 1 ].m_magnitude.Add( parts[ 1 ] );
+    out_values[ 2 ].m_magnitude = std::move( evenSum );
+    AddSigned( out_values[ 2 ], parts[ 1 ], true );
+
+    out_values[ 3 ].m_magnitude = parts[ 2 ];
+    out_values[ 3 ].m_magnitude.Multiply( 2 );
+    out_values[ 3 ].m_magnitude.Add( parts[ 1 ] );
+    out_values[ 3 ].m_magnitude.Multiply( 2 );
+    out_values[ 3 ].m_magnitude.Add( parts[ 0 ] );
+
+    out_values[ 4 ].m_magnitude = parts[ 2 ];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void EvaluateToom4( const SimpleBigNum* parts, SignedNumber* out_values )
+{
+    // Evaluates parts[ 3 ]*x^3 + ... + parts[ 0 ] in points 0, 1, -1, 2, -2, 1/2 ( multiplied by 2^3 ) and infinity.
+    out_values[ 0 ].m_magnitude = parts[ 0 ];
+
+    SimpleBigNum evenSum = parts[ 0 ];
+    evenSum.Add( parts[ 2 ] );
+    SimpleBigNum oddSum = parts[ 1 ];
+    oddSum.Add( parts[ 3 ] );
+    out_values[ 1 ].m_magnitude = evenSum;
+    out_values[ 1 ].m_magnitude.Add( oddSum );
+    out_values[ 2 ].m_magnitude = std::move( evenSum );
+    AddSigned( out_values[ 2 ], oddSum, true );
+
+    // a0 + 4*a2 and 2*a1 + 8*a3
+    evenSum = parts[ 2 ];
+    evenSum.Multiply( 4 );
+    evenSum.Add( parts[ 0 ] );
+    oddSum = parts[ 3 ];
+    oddSum.Multiply( 4 );
+    oddSum.Add( parts[ 1 ] );
+    oddSum.Multiply( 2 );
+    out_values[ 3 ].m_magnitude = evenSum;
+    out_values[ 3 ].m_magnitude.Add( oddSum );
+    out_values[ 4 ].m_magnitude = std::move( evenSum );
+    AddSigned( out_values[ 4 ], oddSum, true );
+
+    // 8*a0 + 4*a1 + 2*a2 + a3
+    out_values[ 5 ].m_magnitude = parts[ 0 ];
+    for( uint32_t partIdx = 1; partIdx < 4; ++partIdx )
+    {
+        out_values[ 5 ].m_magnitude.Multiply( 2 );
+        out_values[ 5 ].m_magnitude.Add( parts[ partIdx ] );
+    }
+
+    out_values[ 6 ].m_magnitude = parts[ 3 ];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Adds size limbs to the buffer. Carry is propagated as far as needed, so buffer has to be big enough to hold it.
+static void AddLimbs( uint64_t* buffer, const uint64_t* limbs, uint32_t size )
+{
+    uint8_t carry = 0;
+    for( uint32_t limbIdx = 0; limbIdx < size; ++limbIdx )
+        carry = internal::AddDigitsWithCarry( carry, buffer[ limbIdx ], limbs[ limbIdx ], buffer[ limbIdx ] );
+
+    for( uint32_t limbIdx = size; carry != 0; ++limbIdx )
+        carry = internal::AddDigitsWithCarry( carry, buffer[ limbIdx ], 0, buffer[ limbIdx ] );
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleBigNum::SimpleBigNum()
+{
+    SetZero();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleBigNum::SimpleBigNum( uint64_t number )
+{
+    m_numberLittleEndian.Resize( 1 );
+    m_numberLittleEndian.Back() = number;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleBigNum::SimpleBigNum( TRawNumberDigits::const_iterator digitsBegin, TRawNumberDigits::const_iterator digitsEnd )
+{
+    AssignRawDigits( digitsBegin, digitsEnd );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleBigNum::SimpleBigNum( SimpleBigNum&& other )
+    : m_numberLittleEndian( std::move( other.m_numberLittleEndian ) )
+{
+    // Moved from buffer is empty.
+    other.SetZero();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleBigNum::SimpleBigNum( const uint64_t* limbsBegin, const uint64_t* limbsEnd )
+{
+    if( limbsBegin == limbsEnd )
+    {
+        SetZero();
+        return;
+    }
+
+    m_numberLittleEndian.Resize( limbsEnd - limbsBegin );
+    memcpy( m_numberLittleEndian.Data(), limbsBegin, ( limbsEnd - limbsBegin ) * sizeof( uint64_t ) );
+    RemoveLeadingZeros();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::Add( const SimpleBigNum& other )
+{
+    const uint32_t otherLimbs = other.GetNumberOfLimbs();
+    m_numberLittleEndian.Resize( std::max( otherLimbs, GetNumberOfLimbs() ) + 1 );
+    sbn::internal::AddInplaceImpl( m_numberLittleEndian.Data(), other.m_numberLittleEndian.Data(), otherLimbs );
+    RemoveLeadingZeros();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::Subtruct( const SimpleBigNum& other )
+{
+    if( other.IsGreaterThen( *this ) )
+    {
+        SetZero();
+        return;
+    }
+
+    const uint32_t otherLimbs = other.GetNumberOfLimbs();
+    sbn::internal::SustructInplaceImpl( m_numberLittleEndian.Data(), other.m_numberLittleEndian.Data(), otherLimbs );
+    RemoveLeadingZeros();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::Multiply( const SimpleBigNum& other )
+{
+    if( IsZero() || other.IsZero() )
+    {
+        SetZero();
+        return;
+    }
+
+    if( &other == this )
+        return SquareImpl();
+
+    MultiplyImpl( other );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::Square()
+{
+    if( IsZero() )
+        return;
+
+    SquareImpl();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::Pow( uint64_t exponent )
+{
+    if( exponent == 0 )
+    {
+        SetOne();
+        return;
+    }
+
+    if( exponent == 1 || IsZero() || IsOne() )
+        return;
+
+    // number = oddPart * 2^zeroBits, so number^exponent = oddPart^exponent * 2^( zeroBits * exponent ).
+    // Power of two has odd part equal to one and is just shifted.
+    uint32_t zeroLimbs = 0;
+    while( m_numberLittleEndian.Data()[ zeroLimbs ] == 0 )
+        ++zeroLimbs;
+
+    uint32_t zeroBits = 0;
+    while( ( ( m_numberLittleEndian.Data()[ zeroLimbs ] >> zeroBits ) & 1 ) == 0 )
+        ++zeroBits;
+
+    // Limbs count of the result has to fit into 32 bits.
+    const uint64_t strippedBits = ( uint64_t )zeroLimbs * internal::DIGIT_BITS + zeroBits;
+    const uint64_t maxShiftBits = ( uint64_t )std::numeric_limits< uint32_t >::max() * internal::DIGIT_BITS;
+    if( strippedBits > maxShiftBits / exponent )
+    {
+        SetZero();
+        return;
+    }
+
+    ShiftRightLimbs( zeroLimbs );
+    ShiftRightBits( zeroBits );
+
+    if( !IsOne() )
+        PowImpl( exponent );
+
+    const uint64_t shiftBits = strippedBits * exponent;
+    ShiftLeftLimbs( ( uint32_t )( shiftBits / internal::DIGIT_BITS ) );
+    ShiftLeftBits( ( uint32_t )( shiftBits % internal::DIGIT_BITS ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::PowImpl( uint64_t exponent )
+{
+    // Number is squared for every bit of the exponent below the most significant one and multiplied by the base for every one bit.
+    // Result has at most bits( base ) * exponent bits. While it is short enough for basecase kernels, it is kept
+    // in two buffers allocated up front for the whole basecase part, so no step reallocates.
+    // Time complexity: O( M(n) ), where n is size of the result.
+
+    const uint64_t resultLimbs = ( ( uint64_t )GetNumberOfBits() * exponent + internal::DIGIT_BITS - 1 ) / internal::DIGIT_BITS;
+    if( resultLimbs == 1 )
+    {
+        // Result fits into single limb, so do all intermediate values.
+        uint64_t result = 1;
+        for( uint64_t power = m_numberLittleEndian.Front(); exponent != 0; exponent >>= 1, power *= power )
+        {
+            if( exponent & 1 )
+                result *= power;
+        }
+        m_numberLittleEndian.Front() = result;
+        return;
+    }
+
+    const SimpleBigNum base = *this;
+    const uint32_t baseSize = base.GetNumberOfLimbs();
+    const uint64_t* baseLimbs = base.m_numberLittleEndian.Data();
+
+    uint32_t bitIndex = internal::DIGIT_BITS - 1 - internal::CountLeadingZeros( exponent );
+    if( baseSize < helpers::KARATSUBA_SQUARE_THRESHOLD )
+    {
+        // Basecase products of n limbs have 2n limbs, which is at most one limb more then the product needs.
+        const uint32_t bufferSize = ( uint32_t )std::min< uint64_t >( resultLimbs, 2 * helpers::KARATSUBA_SQUARE_THRESHOLD + baseSize ) + 1;
+        TLimbs result( GetAllocator() );
+        result.Resize( bufferSize );
+        TLimbs scratch( GetAllocator() );
+        scratch.Resize( bufferSize );
+
+        memcpy( result.Data(), baseLimbs, baseSize * sizeof( uint64_t ) );
+        uint32_t resultSize = baseSize;
+        for( ; bitIndex > 0 && resultSize < helpers::KARATSUBA_SQUARE_THRESHOLD; --bitIndex )
+        {
+            // Everything above resultSize is zero, scratch is zeroed only where the product is written.
+            memset( scratch.Data(), 0, 2 * resultSize * sizeof( uint64_t ) );
+            internal::SquareInplaceImpl( result.Data(), resultSize, scratch.Data() );
+            std::swap( result, scratch );
+            resultSize *= 2;
+            while( result.Data()[ resultSize - 1 ] == 0 )
+                --resultSize;
+
+            if( ( ( exponent >> ( bitIndex - 1 ) ) & 1 ) == 0 )
+                continue;
+
+            if( baseSize == 1 )
+            {
+                const auto overflow = internal::MultiplyByDigitInplaceImpl( result.Data(), resultSize, baseLimbs[ 0 ] );
+                if( overflow != 0 )
+                    result.Data()[ resultSize++ ] = overflow;
+            }
+            else
+            {
+                memset( scratch.Data(), 0, ( resultSize + baseSize ) * sizeof( uint64_t ) );
+                internal::MultiplyInplaceImpl( result.Data(), resultSize, baseLimbs, baseSize, scratch.Data() );
+                std::swap( result, scratch );
+                resultSize += baseSize;
+                while( result.Data()[ resultSize - 1 ] == 0 )
+                    --resultSize;
+            }
+        }
+
+        result.Resize( resultSize );
+        std::swap( m_numberLittleEndian, result );
+    }
+
+    for( ; bitIndex > 0; --bitIndex )
+    {
+        SquareImpl();
+        if( ( ( exponent >> ( bitIndex - 1 ) ) & 1 ) == 0 )
+            continue;
+
+        if( baseSize == 1 )
+            Multiply( baseLimbs[ 0 ] );
+        else
+            MultiplyImpl( base );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::Sqrt()
+{
+    if( GetNumberOfLimbs() == 1 )
+    {
+        m_numberLittleEndian.Front() = helpers::RootDigit( m_numberLittleEndian.Front(), 2 );
+        return;
+    }
+
+    // Newton's iteration root' = ( root + number / root ) / 2 with precision doubling. Every step extends the root of the top
+    // 2 * d bits of the number, which is off by at most one, to the root of the top 4 * d bits with a single division.
+    // Sizes of the divisions double from step to step, so all steps together cost about as much as two last ones.
+    // Time complexity: O( D(n) ), where D(n) is the cost of division.
+    const uint32_t halfBits = ( GetNumberOfBits() - 1 ) / 2;
+    uint32_t stepsCount = 0;
+    while( ( halfBits >> stepsCount ) != 0 )
+        ++stepsCount;
+
+    SimpleBigNum root = 1;
+    uint32_t rootBits = 0;
+    for( uint32_t step = stepsCount; step > 0; --step )
+    {
+        const uint32_t previousRootBits = rootBits;
+        rootBits = halfBits >> ( step - 1 );
+
+        SimpleBigNum quotient = *this;
+        quotient.ShiftRightBits( 2 * halfBits - previousRootBits - rootBits + 1 );
+        quotient.Divide( root );
+        root.ShiftLeftBits( rootBits - previousRootBits - 1 );
+        root.Add( quotient );
+    }
+
+    SimpleBigNum square = root;
+    square.Square();
+    if( square.IsGreaterThen( *this ) )
+        root.Subtruct( 1 );
+
+    std::swap( m_numberLittleEndian, root.m_numberLittleEndian );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::SqrtRem( SimpleBigNum& out_remainder )
+{
+    out_remainder = *this;
+    Sqrt();
+
+    SimpleBigNum square = *this;
+    square.Square();
+    out_remainder.Subtruct( square );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::Root( uint32_t n )
+{
+    if( n == 0 )
+    {
+        SetZero();
+        return;
+    }
+
+    if( n == 1 || IsZero() || IsOne() )
+        return;
+
+    if( n == 2 )
+        return Sqrt();
+
+    // Numbers less then 2^n have root equal to one.
+    const uint32_t numberBits = GetNumberOfBits();
+    if( numberBits <= n )
+    {
+        SetOne();
+        return;
+    }
+
+    if( GetNumberOfLimbs() == 1 )
+    {
+        m_numberLittleEndian.Front() = helpers::RootDigit( m_numberLittleEndian.Front(), n );
+        return;
+    }
+
+    // Root of the number without its lowest n * shift bits gives the top half of the bits of the root.
+    // If r is that root, ( r + 1 ) * 2^shift is greater then the root, so Newton's iteration
+    // root' = ( ( n - 1 ) * root + number / root^(n-1) ) / n started from it decreases monotonically to the root.
+    // Initial value has half of the bits correct, so only a few steps of the full precision are needed.
+    // Time complexity: O( D(n) ), where D(n) is the cost of division.
+    const uint32_t shift = ( numberBits + n - 1 ) / n / 2;
+    SimpleBigNum root = *this;
+    root.ShiftRightBits( n * shift );
+    root.Root( n );
+    root.Add( 1 );
+    root.ShiftLeftBits( shift );
+
+    for( ;; )
+    {
+        SimpleBigNum power = root;
+        power.Pow( n - 1 );
+        SimpleBigNum nextRoot = *this;
+        nextRoot.Divide( power );
+        power = root;
+        power.Multiply( n - 1 );
+        nextRoot.Add( power );
+        nextRoot.Divide( n );
+
+        if( nextRoot.IsGreaterOrEqualTo( root ) )
+            break;
+
+        root = std::move( nextRoot );
+    }
+
+    std::swap( m_numberLittleEndian, root.m_numberLittleEndian );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::Divide( const SimpleBigNum& other )
+{
+    SimpleBigNum remainder;
+    DivideWithRemainder( other, remainder );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::DivMod( const SimpleBigNum& other, SimpleBigNum& out_quotient, SimpleBigNum& out_remainder ) const
+{
+    // Results are stored at the end, so other number may be one of them.
+    SimpleBigNum quotient = *this;
+    SimpleBigNum remainder;
+    quotient.DivideWithRemainder( other, remainder );
+
+    out_quotient = std::move( quotient );
+    out_remainder = std::move( remainder );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::Mod( const SimpleBigNum& other )
+{
+    SimpleBigNum remainder;
+    DivideWithRemainder( other, remainder );
+    std::swap( m_numberLittleEndian, remainder.m_numberLittleEndian );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::PowMod( const SimpleBigNum& exponent, const SimpleBigNum& modulus )
+{
+    if( modulus.IsZero() || modulus.IsOne() )
+    {
+        SetZero();
+        return;
+    }
+
+    if( exponent.IsZero() )
+    {
+        SetOne();
+        return;
+    }
+
+    const internal::ModularMultiplier multiplier( modulus );
+    multiplier.ToInternalForm( *this );
+    if( IsZero() )
+        return;
+
+    // Precompute odd powers base^1, base^3, ..., base^(2^windowSize - 1).
+    const uint32_t exponentBits = exponent.GetNumberOfBits();
+    const uint32_t windowSize = helpers::GetSlidingWindowSize( exponentBits );
+    std::vector< SimpleBigNum > oddPowers( ( size_t )1 << ( windowSize - 1 ) );
+    oddPowers[ 0 ] = std::move( *this );
+    if( oddPowers.size() > 1 )
+    {
+        SimpleBigNum baseSquared = oddPowers[ 0 ];
+        multiplier.SqrMod( baseSquared );
+        for( size_t i = 1; i < oddPowers.size(); ++i )
+        {
+            oddPowers[ i ] = oddPowers[ i - 1 ];
+            multiplier.MulMod( oddPowers[ i ], baseSquared );
+        }
+    }
+
+    // Scan exponent from the most significant bit. Zero bits are squarings, every window starts and ends with one bit,
+    // so it is squared window size times and multiplied once by the precomputed odd power.
+    bool isResultSet = false;
+    uint32_t bitIndex = exponentBits;
+    while( bitIndex > 0 )
+    {
+        if( exponent.GetBits( bitIndex - 1, 1 ) == 0 )
+        {
+            multiplier.SqrMod( *this );
+            --bitIndex;
+            continue;
+        }
+
+        uint32_t currentWindowSize = std::min( windowSize, bitIndex );
+        uint64_t window = exponent.GetBits( bitIndex - currentWindowSize, currentWindowSize );
+        while( ( window & 1 ) == 0 )
+        {
+            window >>= 1;
+            --currentWindowSize;
+        }
+
+        if( isResultSet )
+        {
+            for( uint32_t i = 0; i < currentWindowSize; ++i )
+                multiplier.SqrMod( *this );
+            multiplier.MulMod( *this, oddPowers[ window >> 1 ] );
+        }
+        else
+        {
+            *this = oddPowers[ window >> 1 ];
+            isResultSet = true;
+        }
+
+        bitIndex -= currentWindowSize;
+    }
+
+    multiplier.FromInternalForm( *this );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::Gcd( const SimpleBigNum& other )
+{
+    *this = internal::GcdCalculator::Gcd( *this, other );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::ExtendedGcd( const SimpleBigNum& other, SimpleBigNum& out_x, SimpleBigNum& out_y )
+{
+    if( IsZero() || other.IsZero() )
+    {
+        const bool isGcdThis = other.IsZero() && !IsZero();
+        if( !isGcdThis )
+            *this = other;
+
+        if( isGcdThis )
+            out_x.SetOne();
+        else
+            out_x.SetZero();
+        out_y.SetZero();
+        return;
+    }
+
+    SimpleBigNum x;
+    SimpleBigNum y;
+    SimpleBigNum gcd = internal::GcdCalculator::ExtendedGcd( *this, other, x, &y );
+    out_x = std::move( x );
+    out_y = std::move( y );
+    *this = std::move( gcd );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleBigNum::ModInverse( const SimpleBigNum& modulus )
+{
+    Mod( modulus );
+    if( modulus.IsOne() )
+        return true;
+
+    if( IsZero() )
+        return false;
+
+    // Inverse is the coefficient x of this * x - modulus * y = 1, which is less then modulus.
+    SimpleBigNum inverse;
+    if( !internal::GcdCalculator::ExtendedGcd( *this, modulus, inverse, nullptr ).IsOne() )
+    {
+        SetZero();
+        return false;
+    }
+
+    std::swap( m_numberLittleEndian, inverse.m_numberLittleEndian );
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::DivideWithRemainder( const SimpleBigNum& other, SimpleBigNum& out_remainder )
+{
+    if( other.IsZero() )
+    {
+        SetZero();
+        out_remainder.SetZero();
+        return;
+    }
+
+    if( IsEqualTo( other ) )
+    {
+        out_remainder.SetZero();
+        SetOne();
+        return;
+    }
+
+    if( IsLessThen( other ) )
+    {
+        out_remainder = *this;
+        SetZero();
+        return;
+    }
+
+    // Single limb divisors are divided exactly by the single digit kernel.
+    if( other.GetNumberOfLimbs() == 1 )
+    {
+        out_remainder = SimpleBigNum( DivMod( other.m_numberLittleEndian.Front() ) );
+        return;
+    }
+
+    DivideImpl( other, out_remainder );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::DivideImpl( const SimpleBigNum& other, SimpleBigNum& out_remainder )
+{
+    const uint32_t otherLimbs = other.GetNumberOfLimbs();
+    const uint32_t quotientLimbs = GetNumberOfLimbs() - otherLimbs + 1;
+
+    if( otherLimbs < helpers::BURNIKEL_ZIEGLER_THRESHOLD || quotientLimbs < helpers::BURNIKEL_ZIEGLER_THRESHOLD )
+        return DivideImpl_Schoolbook( other, out_remainder );
+
+    if( otherLimbs < helpers::NEWTON_DIVISION_THRESHOLD )
+        return DivideImpl_BurnikelZiegler( other, out_remainder );
+
+    DivideImpl_Newton( other, out_remainder );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::DivideImpl_Schoolbook( const SimpleBigNum& other, SimpleBigNum& out_remainder )
+{
+    // Knuth's long division, see DivideInplaceImpl. Both numbers are shifted left, so the top bit of the divisor
+    // is set, what keeps estimates of quotient digits close to the real ones. Number gets one more limb for bits shifted out.
+    // Time complexity: O( ( m - n ) * n )
+
+    const uint32_t thisSize = GetNumberOfLimbs();
+    const uint32_t otherSize = other.GetNumberOfLimbs();
+    const uint32_t shift = internal::CountLeadingZeros( other.m_numberLittleEndian.Back() );
+
+    TLimbs divisor( other.m_numberLittleEndian );
+    internal::ShiftLeftInplaceImpl( divisor.Data(), otherSize, shift );
+
+    TLimbs number( GetAllocator() );
+    number.Resize( thisSize + 1 );
+    memcpy( number.Data(), m_numberLittleEndian.Data(), thisSize * sizeof( uint64_t ) );
+    number.Back() = internal::ShiftLeftInplaceImpl( number.Data(), thisSize, shift );
+
+    TLimbs quotient( GetAllocator() );
+    quotient.Resize( thisSize + 1 - otherSize );
+    internal::DivideInplaceImpl( number.Data(), thisSize + 1, divisor.Data(), otherSize, quotient.Data() );
+
+    internal::ShiftRightInplaceImpl( number.Data(), otherSize, shift );
+    out_remainder = SimpleBigNum( number.Data(), number.Data() + otherSize );
+
+    std::swap( m_numberLittleEndian, quotient );
+    RemoveLeadingZeros();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::DivideImpl_BurnikelZiegler( const SimpleBigNum& other, SimpleBigNum& out_remainder )
+{
+    // Burnikel-Ziegler recursive division. Divisor is extended to blockSize = j * 2^k limbs, j < threshold,
+    // and normalized, so it can be halved k times. Number is split into blocks of blockSize limbs,
+    // which are divided from the most significant one, every step dividing 2 blocks by the divisor.
+    // Time complexity: O( m/n * 2 * K(n) * log(n) ), where K(n) is the cost of Karatsuba multiplication
+
+    const uint32_t otherSize = other.GetNumberOfLimbs();
+    uint32_t halvings = 0;
+    while( ( otherSize >> halvings ) >= helpers::BURNIKEL_ZIEGLER_THRESHOLD )
+        ++halvings;
+
+    const uint32_t blockSize = ( ( otherSize + ( 1u << halvings ) - 1 ) >> halvings ) << halvings;
+    const uint32_t extraLimbs = blockSize - otherSize;
+
+    SimpleBigNum divisor = other;
+    divisor.ShiftLeftLimbs( extraLimbs );
+    const uint32_t bitsShift = internal::CountLeadingZeros( divisor.m_numberLittleEndian.Back() );
+    internal::ShiftLeftInplaceImpl( divisor.m_numberLittleEndian.Data(), blockSize, bitsShift );
+
+    SimpleBigNum number = *this;
+    number.ShiftLeftLimbs( extraLimbs );
+    const auto shiftedOut = internal::ShiftLeftInplaceImpl( number.m_numberLittleEndian.Data(), number.GetNumberOfLimbs(), bitsShift );
+    if( shiftedOut != 0 )
+        number.m_numberLittleEndian.PushBack( shiftedOut );
+
+    // Top block is shorter then blockSize, so it is less then normalized divisor.
+    const uint32_t numberOfBlocks = number.GetNumberOfLimbs() / blockSize + 1;
+    std::vector< SimpleBigNum > blocks( numberOfBlocks );
+    number.SplitIntoParts( blockSize, numberOfBlocks, blocks.data() );
+
+    TLimbs quotient( GetAllocator() );
+    quotient.Resize( ( numberOfBlocks - 1 ) * blockSize );
+    SimpleBigNum remainder = blocks.back();
+    for( uint32_t blockIdx = numberOfBlocks - 1; blockIdx > 0; --blockIdx )
+    {
+        SimpleBigNum current = remainder;
+        if( !current.IsZero() )
+            current.ShiftLeftLimbs( blockSize );
+        current.Add( blocks[ blockIdx - 1 ] );
+
+        SimpleBigNum blockQuotient;
+        DivideImpl_BurnikelZiegler2By1( current, divisor, blockSize, blockQuotient, remainder );
+        memcpy( quotient.Data() + ( blockIdx - 1 ) * blockSize, blockQuotient.m_numberLittleEndian.Data(), blockQuotient.GetNumberOfLimbs() * sizeof( uint64_t ) );
+    }
+
+    // Remainder was scaled together with both numbers.
+    remainder.ShiftRightLimbs( extraLimbs );
+    internal::ShiftRightInplaceImpl( remainder.m_numberLittleEndian.Data(), remainder.GetNumberOfLimbs(), bitsShift );
+    remainder.RemoveLeadingZeros();
+    out_remainder = remainder;
+
+    std::swap( m_numberLittleEndian, quotient );
+    RemoveLeadingZeros();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-SimpleBigNum::SimpleBigNum()
+void SimpleBigNum::DivideImpl_BurnikelZiegler2By1( const SimpleBigNum& number, const SimpleBigNum& divisor, uint32_t blockSize, SimpleBigNum& out_quotient, SimpleBigNum& out_remainder )
 {
-    SetZero();
+    if( blockSize % 2 != 0 || blockSize < helpers::BURNIKEL_ZIEGLER_THRESHOLD )
+    {
+        if( number.IsLessThen( divisor ) )
+        {
+            out_quotient.SetZero();
+            out_remainder = number;
+            return;
+        }
+
+        out_quotient = number;
+        out_quotient.DivideImpl_Schoolbook( divisor, out_remainder );
+        return;
+    }
+
+    // number = [ a1, a2, a3, a4 ], each part has halfSize limbs:
+    // [ q1, r ] = [ a1, a2, a3 ] / divisor
+    // [ q2, out_remainder ] = [ r, a4 ] / divisor
+    // out_quotient = [ q1, q2 ]
+    const uint32_t halfSize = blockSize / 2;
+    SimpleBigNum highPart = number;
+    highPart.ShiftRightLimbs( halfSize );
+    SimpleBigNum lowPart;
+    number.SplitIntoParts( halfSize, 1, &lowPart );
+
+    SimpleBigNum highQuotient;
+    SimpleBigNum remainder;
+    DivideImpl_BurnikelZiegler3By2( highPart, divisor, halfSize, highQuotient, remainder );
+
+    if( !remainder.IsZero() )
+        remainder.ShiftLeftLimbs( halfSize );
+    remainder.Add( lowPart );
+    DivideImpl_BurnikelZiegler3By2( remainder, divisor, halfSize, out_quotient, out_remainder );
+
+    if( !highQuotient.IsZero() )
+    {
+        highQuotient.ShiftLeftLimbs( halfSize );
+        highQuotient.Add( out_quotient );
+        out_quotient = highQuotient;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-SimpleBigNum::SimpleBigNum( uint64_t number )
+void SimpleBigNum::DivideImpl_BurnikelZiegler3By2( const SimpleBigNum& number, const SimpleBigNum& divisor, uint32_t halfSize, SimpleBigNum& out_quotient, SimpleBigNum& out_remainder )
 {
-    helpers::BigNumUnion_u64 num;
-    num.m_uint64_t = number;
+    // number = [ a1, a2, a3 ], divisor = [ b1, b2 ], each part has halfSize limbs.
+    // Quotient is estimated from [ a1, a2 ] / b1, what leaves remainder c:
+    // r = [ c, a3 ] - q * b2
+    // Since divisor is normalized, estimate is at most 2 too big, so r is fixed by adding divisor at most twice.
+    SimpleBigNum divisorParts[ 2 ];
+    divisor.SplitIntoParts( halfSize, 2, divisorParts );
+    const SimpleBigNum& divisorLow = divisorParts[ 0 ];
+    const SimpleBigNum& divisorHigh = divisorParts[ 1 ];
 
-    // Code will work on little endian systems only:
-    m_numberLittleEndian.reserve( 8 );
-    m_numberLittleEndian.push_back( num.m_uint8_t[ 0 ] );
-    m_numberLittleEndian.push_back( num.m_uint8_t[ 1 ] );
-    m_numberLittleEndian.push_back( num.m_uint8_t[ 2 ] );
-    m_numberLittleEndian.push_back( num.m_uint8_t[ 3 ] );
-    m_numberLittleEndian.push_back( num.m_uint8_t[ 4 ] );
-    m_numberLittleEndian.push_back( num.m_uint8_t[ 5 ] );
-    m_numberLittleEndian.push_back( num.m_uint8_t[ 6 ] );
-    m_numberLittleEndian.push_back( num.m_uint8_t[ 7 ] );
+    SimpleBigNum highPart = number;
+    highPart.ShiftRightLimbs( halfSize );
+    SimpleBigNum topPart = highPart;
+    topPart.ShiftRightLimbs( halfSize );
+    SimpleBigNum lowPart;
+    number.SplitIntoParts( halfSize, 1, &lowPart );
 
-    RemoveLeadingZeros();
+    SimpleBigNum remainder;
+    if( topPart.IsLessThen( divisorHigh ) )
+    {
+        DivideImpl_BurnikelZiegler2By1( highPart, divisorHigh, halfSize, out_quotient, remainder );
+    }
+    else
+    {
+        // a1 == b1, so q = B^halfSize - 1 and c = [ a1, a2 ] - b1 * B^halfSize + b1
+        out_quotient.SetOne();
+        out_quotient.ShiftLeftLimbs( halfSize );
+        out_quotient.Subtruct( 1 );
+
+        SimpleBigNum shiftedDivisorHigh = divisorHigh;
+        shiftedDivisorHigh.ShiftLeftLimbs( halfSize );
+        remainder = highPart;
+        remainder.Add( divisorHigh );
+        remainder.Subtruct( shiftedDivisorHigh );
+    }
+
+    if( !remainder.IsZero() )
+        remainder.ShiftLeftLimbs( halfSize );
+    remainder.Add( lowPart );
+
+    SimpleBigNum product = out_quotient;
+    product.Multiply( divisorLow );
+    while( remainder.IsLessThen( product ) )
+    {
+        out_quotient.Subtruct( 1 );
+        remainder.Add( divisor );
+    }
+
+    remainder.Subtruct( product );
+    out_remainder = remainder;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-SimpleBigNum::SimpleBigNum( TRawNumberDigits::const_iterator digitsBegin, TRawNumberDigits::const_iterator digitsEnd )
+void SimpleBigNum::DivideImpl_Newton( const SimpleBigNum& other, SimpleBigNum& out_remainder )
 {
-    m_numberLittleEndian.assign( digitsBegin, digitsEnd );
+    // this / other = ( this * ( 256^shift / other ) ) / 256^shift
+    // With shift equal to the number of digits of this number, truncated reciprocal makes
+    // the quotient at most one too small, what is fixed using the remainder.
+    // Time complexity: O( M(n) )
+
+    const uint32_t shift = GetNumberOfDigits();
+    const SimpleBigNum reciprocal = internal::ReciprocalEstimator::Estimate( other, shift );
+
+    SimpleBigNum quotient = *this;
+    quotient.Multiply( reciprocal );
+    quotient.ShitfRight( shift );
+
+    SimpleBigNum product = quotient;
+    product.Multiply( other );
+    out_remainder = *this;
+    out_remainder.Subtruct( product );
+    if( out_remainder.IsGreaterOrEqualTo( other ) )
+    {
+        out_remainder.Subtruct( other );
+        quotient.Add( 1 );
+    }
+
+    std::swap( m_numberLittleEndian, quotient.m_numberLittleEndian );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void SimpleBigNum::Add( const SimpleBigNum& other )
+void SimpleBigNum::Add( uint64_t other )
 {
-    const uint32_t otherDigits = other.GetNumberOfDigits();
-    m_numberLittleEndian.resize( std::max( otherDigits, GetNumberOfDigits() ) + 1 );
-    sbn::internal::AddInplaceImpl( m_numberLittleEndian.data(), other.m_numberLittleEndian.data(), otherDigits );
-    RemoveLeadingZeros();
+    if( internal::AddDigitInplaceImpl( m_numberLittleEndian.Data(), GetNumberOfLimbs(), other ) != 0 )
+        m_numberLittleEndian.PushBack( 1 );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void SimpleBigNum::Subtruct( const SimpleBigNum& other )
+void SimpleBigNum::Subtruct( uint64_t other )
 {
-    if( other.IsGreaterThen( *this ) )
+    if( IsLessThen( other ) )
     {
         SetZero();
         return;
     }
 
-    const uint32_t otherDigits = other.GetNumberOfDigits();
-    sbn::internal::SustructInplaceImpl( m_numberLittleEndian.data(), other.m_numberLittleEndian.data(), otherDigits );
+    internal::SubtructDigitInplaceImpl( m_numberLittleEndian.Data(), GetNumberOfLimbs(), other );
     RemoveLeadingZeros();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void SimpleBigNum::Multiply( const SimpleBigNum& other )
+void SimpleBigNum::Multiply( uint64_t other )
 {
-    if( IsZero() || other.IsZero() )
+    if( IsZero() || other == 0 )
     {
         SetZero();
         return;
     }
 
-    MultiplyImpl_Karatsuba( other );
+    const auto overflow = internal::MultiplyByDigitInplaceImpl( m_numberLittleEndian.Data(), GetNumberOfLimbs(), other );
+    if( overflow != 0 )
+        m_numberLittleEndian.PushBack( overflow );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void SimpleBigNum::Divide( const SimpleBigNum& other )
+void SimpleBigNum::Divide( uint64_t other )
 {
-    if( IsEqualTo( other ) )
-    {
-        SetOne();
-        return;
-    }
+    DivMod( other );
+}
 
-    if( IsLessThen( other ) )
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint64_t SimpleBigNum::DivMod( uint64_t other )
+{
+    if( other == 0 )
     {
         SetZero();
-        return;
+        return 0;
     }
 
-    const auto shift = GetNumberOfDigits() + GetNumberOfDigits()/4;
-    const auto reciprocal = internal::ReciprocalEstimator::Estimate( other, shift, 100 );
+    const auto remainder = internal::DivideByDigitInplaceImpl( m_numberLittleEndian.Data(), GetNumberOfLimbs(), other );
+    RemoveLeadingZeros();
+    return remainder;
+}
 
-    Multiply( reciprocal );
-    ShitfRight( shift );
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::Mod( uint64_t other )
+{
+    const auto remainder = DivMod( other );
+    m_numberLittleEndian.Resize( 1 );
+    m_numberLittleEndian.Front() = remainder;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void SimpleBigNum::ShitfLeft( uint32_t value )
 {
-    const auto orginalDigits = GetNumberOfDigits();
-    m_numberLittleEndian.resize( orginalDigits + value );
-    memmove( m_numberLittleEndian.data() + value, m_numberLittleEndian.data(), orginalDigits * sizeof( TRawNumberDigits::value_type ) );
-    memset( m_numberLittleEndian.data(), 0, value * sizeof( TRawNumberDigits::value_type ) );
+    if( IsZero() )
+        return;
+
+    // Shift by whole limbs first, then shift remaining base 256 digits as bits:
+    ShiftLeftLimbs( value / internal::DIGIT_BYTES );
+
+    const uint32_t bitsShift = ( value % internal::DIGIT_BYTES ) * 8;
+    const auto shiftedOut = internal::ShiftLeftInplaceImpl( m_numberLittleEndian.Data(), GetNumberOfLimbs(), bitsShift );
+    if( shiftedOut != 0 )
+        m_numberLittleEndian.PushBack( shiftedOut );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void SimpleBigNum::ShitfRight( uint32_t value )
 {
-    const auto orginalDigits = GetNumberOfDigits();
-    if( value >= orginalDigits )
-    {
-        SetZero();
-        return;
-    }
+    // Shift by whole limbs first, then shift remaining base 256 digits as bits:
+    ShiftRightLimbs( value / internal::DIGIT_BYTES );
 
-    const auto digitsAfterShift = orginalDigits - value;
-    memmove( m_numberLittleEndian.data(), m_numberLittleEndian.data() + value, digitsAfterShift * sizeof( TRawNumberDigits::value_type ) );
-    m_numberLittleEndian.resize( digitsAfterShift );
+    const uint32_t bitsShift = ( value % internal::DIGIT_BYTES ) * 8;
+    internal::ShiftRightInplaceImpl( m_numberLittleEndian.Data(), GetNumberOfLimbs(), bitsShift );
+    RemoveLeadingZeros();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #define COMPARE_IMPL( op )                                                                              \
-    if( other.GetNumberOfDigits() == GetNumberOfDigits() )                                              \
+    if( other.GetNumberOfLimbs() == GetNumberOfLimbs() )                                                \
     {                                                                                                   \
-        uint32_t i = GetNumberOfDigits() - 1;                                                           \
-        while( i > 0 && ( m_numberLittleEndian[ i ] == other.m_numberLittleEndian[ i ] ) ) --i;         \
-        return  m_numberLittleEndian[ i ] op other.m_numberLittleEndian[ i ];                           \
+        uint32_t i = GetNumberOfLimbs() - 1;                                                            \
+        while( i > 0 && ( m_numberLittleEndian.At( i ) == other.m_numberLittleEndian.At( i ) ) ) --i;   \
+        return  m_numberLittleEndian.At( i ) op other.m_numberLittleEndian.At( i );                     \
     }                                                                                                   \
-    return  GetNumberOfDigits() op other.GetNumberOfDigits();
+    return  GetNumberOfLimbs() op other.GetNumberOfLimbs();
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 bool SimpleBigNum::IsGreaterThen( const SimpleBigNum& other ) const
@@ -157,12 +1096,30 @@ bool SimpleBigNum::IsLessThen( const SimpleBigNum & other ) const
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 bool SimpleBigNum::IsEqualTo( const SimpleBigNum& other ) const
 {
-    return m_numberLittleEndian == other.m_numberLittleEndian;
+    return m_numberLittleEndian.IsEqualTo( other.m_numberLittleEndian );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleBigNum::IsGreaterThen( uint64_t other ) const
+{
+    return GetNumberOfLimbs() > 1 || m_numberLittleEndian.Front() > other;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleBigNum::IsLessThen( uint64_t other ) const
+{
+    return GetNumberOfLimbs() == 1 && m_numberLittleEndian.Front() < other;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleBigNum::IsEqualTo( uint64_t other ) const
+{
+    return GetNumberOfLimbs() == 1 && m_numberLittleEndian.Front() == other;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #define IS_NUMBER_EQUAL_TO( digit )                                                     \
-    if( ( GetNumberOfDigits() == 1 ) && ( m_numberLittleEndian.back() == digit ) )      \
+    if( ( GetNumberOfLimbs() == 1 ) && ( m_numberLittleEndian.Back() == digit ) )       \
         return true;                                                                    \
     return false;
 
@@ -180,8 +1137,8 @@ bool SimpleBigNum::IsOne() const
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #define SET_NUMBER_TO( digit )                  \
-       m_numberLittleEndian.resize( 1 );        \
-       m_numberLittleEndian.back() = digit;     \
+       m_numberLittleEndian.Resize( 1 );        \
+       m_numberLittleEndian.Back() = digit;     \
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void SimpleBigNum::SetZero()
@@ -198,61 +1155,258 @@ void SimpleBigNum::SetOne()
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 uint32_t SimpleBigNum::GetNumberOfDigits() const
 {
-    return ( uint32_t )m_numberLittleEndian.size();
+    const internal::TDigitType mostSignificantLimb = m_numberLittleEndian.Back();
+    const uint32_t mostSignificantLimbBits = mostSignificantLimb == 0 ? 1 : internal::DIGIT_BITS - internal::CountLeadingZeros( mostSignificantLimb );
+    return ( GetNumberOfLimbs() - 1 ) * internal::DIGIT_BYTES + ( mostSignificantLimbBits + 7 ) / 8;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 std::string SimpleBigNum::ToString( bool addSeparators ) const
 {
-    std::string outString;
-    auto numberBase10 = ConvertNumber( m_numberLittleEndian, 256, 10 );
+    std::string digits = internal::DecimalConverter::ToString( *this );
+    if( !addSeparators )
+        return digits;
 
-    for( size_t i = numberBase10.size(); i > 0; --i )
+    // Separator is placed before every group of three digits, except the first one.
+    std::string outString;
+    outString.reserve( digits.size() + digits.size() / 3 );
+    for( size_t i = 0; i < digits.size(); ++i )
     {
-        outString += std::to_string( numberBase10[ i - 1 ] );
-        if( addSeparators && ( i - 1 ) % 3 == 0 )
-            outString += ",";
+        if( i > 0 && ( digits.size() - i ) % 3 == 0 )
+            outString += ',';
+        outString += digits[ i ];
     }
 
-    if( addSeparators )
-        outString.resize( outString.size() - 1 );
     return outString;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void SimpleBigNum::FromString( const std::string& numberBase10 )
+bool SimpleBigNum::FromString( const std::string& numberBase10 )
+{
+    return internal::DecimalConverter::FromString( numberBase10, *this );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::string SimpleBigNum::ToHexString() const
+{
+    return internal::RadixConverter::ToString( *this, 16 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleBigNum::FromHexString( const std::string& numberBase16 )
+{
+    return internal::RadixConverter::FromString( numberBase16, 16, *this );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::string SimpleBigNum::ToPowerOfTwoBaseString( uint32_t base ) const
+{
+    return internal::RadixConverter::ToString( *this, base );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleBigNum::FromPowerOfTwoBaseString( const std::string& number, uint32_t base )
+{
+    return internal::RadixConverter::FromString( number, base, *this );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::AssignRawDigits( TRawNumberDigits::const_iterator digitsBegin, TRawNumberDigits::const_iterator digitsEnd )
+{
+    const size_t digits = digitsEnd - digitsBegin;
+    if( digits == 0 )
+    {
+        SetZero();
+        return;
+    }
+
+    // Code will work on little endian systems only:
+    m_numberLittleEndian.Resize( ( digits + internal::DIGIT_BYTES - 1 ) / internal::DIGIT_BYTES );
+    m_numberLittleEndian.SetZero();
+    memcpy( m_numberLittleEndian.Data(), &*digitsBegin, digits );
+    RemoveLeadingZeros();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleBigNum::TRawNumberDigits SimpleBigNum::GetRawDigits() const
+{
+    // Code will work on little endian systems only:
+    TRawNumberDigits rawDigits( GetNumberOfDigits() );
+    memcpy( rawDigits.data(), m_numberLittleEndian.Data(), rawDigits.size() );
+    return rawDigits;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t SimpleBigNum::GetNumberOfLimbs() const
+{
+    return ( uint32_t )m_numberLittleEndian.Size();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t SimpleBigNum::GetNumberOfBits() const
+{
+    const internal::TDigitType mostSignificantLimb = m_numberLittleEndian.Back();
+    if( mostSignificantLimb == 0 )
+        return 0;
+
+    return GetNumberOfLimbs() * internal::DIGIT_BITS - internal::CountLeadingZeros( mostSignificantLimb );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint64_t SimpleBigNum::GetBits( uint32_t bitIndex, uint32_t bitsCount ) const
+{
+    const uint32_t limbIndex = bitIndex / internal::DIGIT_BITS;
+    const uint32_t bitOffset = bitIndex % internal::DIGIT_BITS;
+    if( limbIndex >= GetNumberOfLimbs() )
+        return 0;
+
+    uint64_t bits = m_numberLittleEndian.Data()[ limbIndex ] >> bitOffset;
+    if( bitOffset != 0 && bitOffset + bitsCount > internal::DIGIT_BITS && limbIndex + 1 < GetNumberOfLimbs() )
+        bits |= m_numberLittleEndian.Data()[ limbIndex + 1 ] << ( internal::DIGIT_BITS - bitOffset );
+
+    return bitsCount < internal::DIGIT_BITS ? bits & ( ( ( uint64_t )1 << bitsCount ) - 1 ) : bits;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::ShiftLeftLimbs( uint32_t value )
+{
+    const auto orginalLimbs = GetNumberOfLimbs();
+    m_numberLittleEndian.Resize( orginalLimbs + value );
+    memmove( m_numberLittleEndian.Data() + value, m_numberLittleEndian.Data(), orginalLimbs * sizeof( uint64_t ) );
+    memset( m_numberLittleEndian.Data(), 0, value * sizeof( uint64_t ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::ShiftRightLimbs( uint32_t value )
+{
+    const auto orginalLimbs = GetNumberOfLimbs();
+    if( value >= orginalLimbs )
+    {
+        SetZero();
+        return;
+    }
+
+    const auto limbsAfterShift = orginalLimbs - value;
+    memmove( m_numberLittleEndian.Data(), m_numberLittleEndian.Data() + value, limbsAfterShift * sizeof( uint64_t ) );
+    m_numberLittleEndian.Resize( limbsAfterShift );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::ShiftLeftBits( uint32_t value )
 {
-    TRawNumberDigits rawNumberBase10;
-    rawNumberBase10.reserve( numberBase10.size() );
+    if( IsZero() )
+        return;
 
-    for( size_t i = numberBase10.size(); i > 0; --i )
-        rawNumberBase10.push_back( numberBase10[ i - 1 ] - '0' );
+    ShiftLeftLimbs( value / internal::DIGIT_BITS );
+    const auto shiftedOut = internal::ShiftLeftInplaceImpl( m_numberLittleEndian.Data(), GetNumberOfLimbs(), value % internal::DIGIT_BITS );
+    if( shiftedOut != 0 )
+        m_numberLittleEndian.PushBack( shiftedOut );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::ShiftRightBits( uint32_t value )
+{
+    ShiftRightLimbs( value / internal::DIGIT_BITS );
+    internal::ShiftRightInplaceImpl( m_numberLittleEndian.Data(), GetNumberOfLimbs(), value % internal::DIGIT_BITS );
+    RemoveLeadingZeros();
+}
 
-    m_numberLittleEndian = ConvertNumber( rawNumberBase10, 10, 256 );
+////////////////////////////////////////////////////////////////////////////////////////////////////
+tools::IAllocator& SimpleBigNum::GetAllocator()
+{
+    static tools::AlignedAllocator allocator;
+    return allocator;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void SimpleBigNum::RemoveLeadingZeros()
 {
-    size_t i = m_numberLittleEndian.size() - 1;
+    size_t i = m_numberLittleEndian.Size() - 1;
     size_t toRemove = 0;
 
-    while( i > 0 && m_numberLittleEndian[ i-- ] == 0 )
+    while( i > 0 && m_numberLittleEndian.At( i-- ) == 0 )
         ++toRemove;
 
-    m_numberLittleEndian.resize( m_numberLittleEndian.size() - toRemove );
+    m_numberLittleEndian.Resize( m_numberLittleEndian.Size() - toRemove );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::SplitIntoParts( uint32_t partSize, uint32_t numberOfParts, SimpleBigNum* out_parts ) const
+{
+    const uint64_t* limbs = m_numberLittleEndian.Data();
+    for( uint32_t partIdx = 0; partIdx < numberOfParts; ++partIdx )
+    {
+        const uint32_t partBegin = std::min( partIdx * partSize, GetNumberOfLimbs() );
+        const uint32_t partEnd = std::min( partBegin + partSize, GetNumberOfLimbs() );
+        out_parts[ partIdx ] = SimpleBigNum( limbs + partBegin, limbs + partEnd );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::MultiplyImpl( const SimpleBigNum& other )
+{
+    const uint32_t biggerLimbs = std::max( GetNumberOfLimbs(), other.GetNumberOfLimbs() );
+    const uint32_t smallerLimbs = std::min( GetNumberOfLimbs(), other.GetNumberOfLimbs() );
+
+    if( biggerLimbs < helpers::KARATSUBA_THRESHOLD )
+        return MultiplyImpl_Basecase( other );
+
+    // Karatsuba handles unbalanced numbers itself, Toom and NTT would waste work on zero parts.
+    if( smallerLimbs >= helpers::TOOM3_THRESHOLD && biggerLimbs >= helpers::UNBALANCED_RATIO * smallerLimbs )
+        return MultiplyImpl_Unbalanced( other );
+
+    if( smallerLimbs >= helpers::NTT_THRESHOLD )
+        return MultiplyImpl_Ntt( other );
+
+    if( smallerLimbs >= helpers::TOOM4_THRESHOLD )
+        return MultiplyImpl_Toom4( other );
+
+    if( smallerLimbs >= helpers::TOOM3_THRESHOLD )
+        return MultiplyImpl_Toom3( other );
+
+    MultiplyImpl_Karatsuba( other );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void SimpleBigNum::MultiplyImpl_Basecase( const SimpleBigNum& other )
 {
     // Simple O(n^2) multiplication algorithm:
-    const uint32_t thisSize = GetNumberOfDigits();
-    const uint32_t otherSize = other.GetNumberOfDigits();
+    const uint32_t thisSize = GetNumberOfLimbs();
+    const uint32_t otherSize = other.GetNumberOfLimbs();
     const uint32_t newSize = thisSize + otherSize;
 
-    TRawNumberDigits newNumber( newSize );
-    sbn::internal::MultiplyInplaceImpl( m_numberLittleEndian.data(), thisSize, other.m_numberLittleEndian.data(), otherSize, newNumber.data() );
+    TLimbs newNumber( GetAllocator() );
+    newNumber.Resize( newSize );
+    sbn::internal::MultiplyInplaceImpl( m_numberLittleEndian.Data(), thisSize, other.m_numberLittleEndian.Data(), otherSize, newNumber.Data() );
+    std::swap( m_numberLittleEndian, newNumber );
+    RemoveLeadingZeros();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::MultiplyImpl_Unbalanced( const SimpleBigNum& other )
+{
+    // Bigger number is sliced into chunks of the size of the smaller one:
+    // bigger = sum( chunk_i * B^(i*n) ), bigger * smaller = sum( ( chunk_i * smaller ) * B^(i*n) )
+    // All products are balanced, so each of them uses the best method for n limbs.
+    // Time complexity: O( m/n * M(n) )
+
+    const bool isThisBigger = GetNumberOfLimbs() >= other.GetNumberOfLimbs();
+    const SimpleBigNum& bigger = isThisBigger ? *this : other;
+    const SimpleBigNum& smaller = isThisBigger ? other : *this;
+    const uint32_t biggerSize = bigger.GetNumberOfLimbs();
+    const uint32_t smallerSize = smaller.GetNumberOfLimbs();
+    const uint64_t* biggerLimbs = bigger.m_numberLittleEndian.Data();
+
+    TLimbs newNumber( GetAllocator() );
+    newNumber.Resize( biggerSize + smallerSize );
+    for( uint32_t offset = 0; offset < biggerSize; offset += smallerSize )
+    {
+        const uint32_t chunkSize = std::min( smallerSize, biggerSize - offset );
+        SimpleBigNum chunk( biggerLimbs + offset, biggerLimbs + offset + chunkSize );
+        chunk.MultiplyImpl( smaller );
+        helpers::AddLimbs( newNumber.Data() + offset, chunk.m_numberLittleEndian.Data(), chunk.GetNumberOfLimbs() );
+    }
+
     std::swap( m_numberLittleEndian, newNumber );
     RemoveLeadingZeros();
 }
@@ -260,116 +1414,270 @@ void SimpleBigNum::MultiplyImpl_Basecase( const SimpleBigNum& other )
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void SimpleBigNum::MultiplyImpl_Karatsuba( const SimpleBigNum& other )
 {
-    // Karatsuba method:
-    // thisNumber = ( thisHightPart*B + thisLowPart )
-    // otherNumber = ( otherHightPart*B + otherLowPart )
-    //
-    // z1 = thisHightPart * otherHightPart
-    // z2 = thisLowPart * otherLowPart
-    // z3 = ( thisHightPart + thisLowPart ) * ( otherHightPart + otherLowPart ) - z1 - z2
-    // final = z1*B*B + z3*B + z2
+    // Karatsuba method, see KaratsubaMultiplier. Whole recursion works on raw limbs,
+    // so the only allocations are the result and one scratch buffer.
     // Time complexity: O( n^log2(3) )
 
-    const SimpleBigNum& bigger = std::max( *this, other );
-    const SimpleBigNum& smaller = std::min( *this, other );
+    const bool isThisBigger = GetNumberOfLimbs() >= other.GetNumberOfLimbs();
+    const SimpleBigNum& bigger = isThisBigger ? *this : other;
+    const SimpleBigNum& smaller = isThisBigger ? other : *this;
+    const uint32_t biggerSize = bigger.GetNumberOfLimbs();
+    const uint32_t smallerSize = smaller.GetNumberOfLimbs();
 
-    if( bigger.GetNumberOfDigits() < helpers::KARATSUBA_THRESHOLD )
-        return MultiplyImpl_Basecase( other );
+    TLimbs newNumber( GetAllocator() );
+    newNumber.Resize( biggerSize + smallerSize );
+    TLimbs scratch( GetAllocator() );
+    scratch.Resize( internal::KaratsubaMultiplier::GetMultiplyScratchSize( biggerSize ) );
+    internal::KaratsubaMultiplier::Multiply(
+        bigger.m_numberLittleEndian.Data(), biggerSize, smaller.m_numberLittleEndian.Data(), smallerSize, newNumber.Data(), scratch.Data() );
+
+    std::swap( m_numberLittleEndian, newNumber );
+    RemoveLeadingZeros();
+}
 
-    const auto exponent = bigger.GetNumberOfDigits() / 2;
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::MultiplyImpl_Toom3( const SimpleBigNum& other )
+{
+    // Toom-3 method:
+    // thisNumber = a2*x^2 + a1*x + a0, otherNumber = b2*x^2 + b1*x + b0, where x = B^partSize
+    // Both polynomials are evaluated in points 0, 1, -1, 2, infinity and multiplied pointwise.
+    // Coefficients of the product r( x ) = c4*x^4 + ... + c0 are interpolated:
+    // c0 = r( 0 ), c4 = r( inf )
+    // c2 = ( r( 1 ) + r( -1 ) ) / 2 - c0 - c4
+    // c3 = ( ( r( 2 ) - c0 - 4*c2 - 16*c4 ) / 2 - ( r( 1 ) - r( -1 ) ) / 2 ) / 3
+    // c1 = ( r( 1 ) - r( -1 ) ) / 2 - c3
+    // Time complexity: O( n^log3(5) )
 
-    SimpleBigNum z2( bigger.m_numberLittleEndian.begin(), bigger.m_numberLittleEndian.begin() + exponent );
-    SimpleBigNum z1( bigger.m_numberLittleEndian.begin() + exponent, bigger.m_numberLittleEndian.end() );
+    const bool isSquare = ( &other == this );
+    const uint32_t partSize = ( std::max( GetNumberOfLimbs(), other.GetNumberOfLimbs() ) + 2 ) / 3;
 
-    SimpleBigNum otherLowPart;
-    SimpleBigNum otherHighPart;
+    SimpleBigNum parts[ 3 ];
+    helpers::SignedNumber values[ 5 ];
+    SplitIntoParts( partSize, 3, parts );
+    helpers::EvaluateToom3( parts, values );
 
-    if( smaller.GetNumberOfDigits() > exponent )
+    helpers::SignedNumber otherValues[ 5 ];
+    if( !isSquare )
     {
-        otherLowPart = SimpleBigNum( smaller.m_numberLittleEndian.begin(), smaller.m_numberLittleEndian.begin() + exponent );
-        otherHighPart = SimpleBigNum( smaller.m_numberLittleEndian.begin() + exponent, smaller.m_numberLittleEndian.end() );
-    }
-    else
-    {
-        otherLowPart = SimpleBigNum( smaller.m_numberLittleEndian.begin(), smaller.m_numberLittleEndian.end() );
+        other.SplitIntoParts( partSize, 3, parts );
+        helpers::EvaluateToom3( parts, otherValues );
     }
 
-    SimpleBigNum z3 = z2;
-    z3.Add( z1 );
+    for( uint32_t pointIdx = 0; pointIdx < 5; ++pointIdx )
+        helpers::MultiplySigned( values[ pointIdx ], otherValues[ pointIdx ], isSquare );
+
+    const SimpleBigNum& c0 = values[ 0 ].m_magnitude;
+    const SimpleBigNum& c4 = values[ 4 ].m_magnitude;
 
-    SimpleBigNum sum2 = otherLowPart;
-    sum2.Add( otherHighPart );
+    helpers::SignedNumber c2 = values[ 1 ];
+    helpers::AddSigned( c2, values[ 2 ] );
+    helpers::DivideSignedExact( c2, 2 );
+    helpers::SubtructSigned( c2, c0, 1 );
+    helpers::SubtructSigned( c2, c4, 1 );
 
-    z1.MultiplyImpl_Karatsuba( otherHighPart );
-    z2.MultiplyImpl_Karatsuba( otherLowPart );
-    z3.MultiplyImpl_Karatsuba( sum2 );
-    z3.Subtruct( z1 );
-    z3.Subtruct( z2 );
+    helpers::SignedNumber oddSum = values[ 1 ];
+    helpers::SubtructSigned( oddSum, values[ 2 ] );
+    helpers::DivideSignedExact( oddSum, 2 );
 
-    z1.ShitfLeft( exponent + exponent );
-    z3.ShitfLeft( exponent );
-    z1.Add( z3 );
-    z1.Add( z2 );
+    helpers::SignedNumber c3 = values[ 3 ];
+    helpers::SubtructSigned( c3, c0, 1 );
+    helpers::SubtructSigned( c3, c2, 4 );
+    helpers::SubtructSigned( c3, c4, 16 );
+    helpers::DivideSignedExact( c3, 2 );
+    helpers::SubtructSigned( c3, oddSum );
+    helpers::DivideSignedExact( c3, 3 );
 
-    *this = std::move( z1 );
+    helpers::SignedNumber c1 = std::move( oddSum );
+    helpers::SubtructSigned( c1, c3 );
+
+    // All coefficients of the product are non negative.
+    SimpleBigNum* coefficients[] = { &values[ 0 ].m_magnitude, &c1.m_magnitude, &c2.m_magnitude, &c3.m_magnitude, &values[ 4 ].m_magnitude };
+    SimpleBigNum result = std::move( *coefficients[ 4 ] );
+    for( uint32_t coefficientIdx = 4; coefficientIdx > 0; --coefficientIdx )
+    {
+        result.ShiftLeftLimbs( partSize );
+        result.Add( *coefficients[ coefficientIdx - 1 ] );
+    }
+
+    result.RemoveLeadingZeros();
+    *this = std::move( result );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-std::vector<uint8_t> SimpleBigNum::ConvertNumber( const std::vector<uint8_t>& srcNumber, uint16_t srcBase, uint16_t dstBase ) const
+void SimpleBigNum::MultiplyImpl_Toom4( const SimpleBigNum& other )
 {
-    std::vector< uint8_t > dstNumber = { 0 };
-    dstNumber.reserve( srcNumber.size() );
+    // Toom-4 method:
+    // thisNumber = a3*x^3 + a2*x^2 + a1*x + a0, otherNumber = b3*x^3 + b2*x^2 + b1*x + b0, where x = B^partSize
+    // Both polynomials are evaluated in points 0, 1, -1, 2, -2, 1/2, infinity and multiplied pointwise.
+    // Value in 1/2 is scaled by 2^3, so product rh = 2^6 * r( 1/2 ) is integer.
+    // Coefficients of the product r( x ) = c6*x^6 + ... + c0 are interpolated:
+    // c0 = r( 0 ), c6 = r( inf )
+    // E1 = ( r( 1 ) + r( -1 ) ) / 2, O1 = ( r( 1 ) - r( -1 ) ) / 2,
+    // E2 = ( r( 2 ) + r( -2 ) ) / 2, O2 = ( r( 2 ) - r( -2 ) ) / 4
+    // S = E1 - c0 - c6 = c2 + c4, T = E2 - c0 - 64*c6 = 4*c2 + 16*c4
+    // c4 = ( T - 4*S ) / 12, c2 = S - c4
+    // V = ( rh - 64*c0 - 16*c2 - 4*c4 - c6 ) / 2 = 16*c1 + 4*c3 + c5
+    // P = ( O2 - O1 ) / 3 = c3 + 5*c5, Q = ( V - O1 ) / 3 = 5*c1 + c3
+    // c3 = ( 5*O1 - P - Q ) / 3, c1 = ( Q - c3 ) / 5, c5 = ( P - c3 ) / 5
+    // Time complexity: O( n^log4(7) )
 
-    // [NOTE]: To convert srcNumber with srcBase to dstNumber with dstBase, function 
-    // uses general alogithm of the form:
-    // dstNumber = 0
-    // foreach srcDigit in srcNumber:
-    //      dstNumber = dstNumber * srcBase
-    //      dstNumber = dstNumber + srcDigit
+    const bool isSquare = ( &other == this );
+    const uint32_t partSize = ( std::max( GetNumberOfLimbs(), other.GetNumberOfLimbs() ) + 3 ) / 4;
 
-    const uint16_t dstBaseU16 = dstBase;
+    SimpleBigNum parts[ 4 ];
+    helpers::SignedNumber values[ 7 ];
+    SplitIntoParts( partSize, 4, parts );
+    helpers::EvaluateToom4( parts, values );
 
-    for( size_t i = srcNumber.size(); i > 0; --i )
+    helpers::SignedNumber otherValues[ 7 ];
+    if( !isSquare )
     {
-        // Multiply current dst number by srcBase:
-        uint16_t multOverflow = 0;
-        for( size_t j = 0; j < dstNumber.size(); ++j )
-        {
-            uint16_t wantedDstDigit = ( dstNumber[ j ] * srcBase ) + multOverflow;
-            uint16_t finalDstDigit = wantedDstDigit % dstBaseU16;
-            dstNumber[ j ] = ( uint8_t )finalDstDigit;
-            multOverflow = wantedDstDigit / dstBaseU16;
-        }
+        other.SplitIntoParts( partSize, 4, parts );
+        helpers::EvaluateToom4( parts, otherValues );
+    }
 
-        while( multOverflow != 0 )
-        {
-            uint8_t dstDigit = ( uint8_t )( multOverflow % dstBaseU16 );
-            dstNumber.push_back( dstDigit );
-            multOverflow /= dstBaseU16;
-        };
-
-        // Add current srcDigit expressed in dstBase:
-        size_t dstDigitIdx = 0;
-        uint16_t srcDigit = srcNumber[ i - 1 ];
-        do
-        {
-            uint16_t dstDigit = srcDigit % dstBaseU16;
-            uint16_t wantedDstDigit = dstDigit + dstNumber[ dstDigitIdx ];
+    for( uint32_t pointIdx = 0; pointIdx < 7; ++pointIdx )
+        helpers::MultiplySigned( values[ pointIdx ], otherValues[ pointIdx ], isSquare );
 
-            dstNumber[ dstDigitIdx ] = ( uint8_t )( wantedDstDigit % dstBaseU16 );
-            uint16_t dstDigitOverflow = ( wantedDstDigit / dstBaseU16 );
-            srcDigit = ( srcDigit / dstBaseU16 );
-            srcDigit += dstDigitOverflow;
-            ++dstDigitIdx;
-        } while( srcDigit != 0 && dstDigitIdx < dstNumber.size() );
+    const SimpleBigNum& c0 = values[ 0 ].m_magnitude;
+    const SimpleBigNum& c6 = values[ 6 ].m_magnitude;
 
-        while( srcDigit != 0 )
-        {
-            uint8_t dstDigit = ( uint8_t )( srcDigit % dstBaseU16 );
-            dstNumber.push_back( dstDigit );
-            srcDigit = ( srcDigit / dstBaseU16 );
-        };
+    helpers::SignedNumber oddSum1 = values[ 1 ];
+    helpers::SubtructSigned( oddSum1, values[ 2 ] );
+    helpers::DivideSignedExact( oddSum1, 2 );
+
+    helpers::SignedNumber oddSum2 = values[ 3 ];
+    helpers::SubtructSigned( oddSum2, values[ 4 ] );
+    helpers::DivideSignedExact( oddSum2, 4 );
+
+    // S = c2 + c4
+    helpers::SignedNumber evenSum1 = values[ 1 ];
+    helpers::AddSigned( evenSum1, values[ 2 ] );
+    helpers::DivideSignedExact( evenSum1, 2 );
+    helpers::SubtructSigned( evenSum1, c0, 1 );
+    helpers::SubtructSigned( evenSum1, c6, 1 );
+
+    // c4 = ( T - 4*S ) / 12
+    helpers::SignedNumber c4 = values[ 3 ];
+    helpers::AddSigned( c4, values[ 4 ] );
+    helpers::DivideSignedExact( c4, 2 );
+    helpers::SubtructSigned( c4, c0, 1 );
+    helpers::SubtructSigned( c4, c6, 64 );
+    helpers::SubtructSigned( c4, evenSum1, 4 );
+    helpers::DivideSignedExact( c4, 12 );
+
+    helpers::SignedNumber c2 = std::move( evenSum1 );
+    helpers::SubtructSigned( c2, c4 );
+
+    // V = 16*c1 + 4*c3 + c5
+    helpers::SignedNumber oddSumHalf = values[ 5 ];
+    helpers::SubtructSigned( oddSumHalf, c0, 64 );
+    helpers::SubtructSigned( oddSumHalf, c2, 16 );
+    helpers::SubtructSigned( oddSumHalf, c4, 4 );
+    helpers::SubtructSigned( oddSumHalf, c6, 1 );
+    helpers::DivideSignedExact( oddSumHalf, 2 );
+
+    // P = c3 + 5*c5, Q = 5*c1 + c3
+    helpers::SignedNumber p = std::move( oddSum2 );
+    helpers::SubtructSigned( p, oddSum1 );
+    helpers::DivideSignedExact( p, 3 );
+
+    helpers::SignedNumber q = std::move( oddSumHalf );
+    helpers::SubtructSigned( q, oddSum1 );
+    helpers::DivideSignedExact( q, 3 );
+
+    helpers::SignedNumber c3 = std::move( oddSum1 );
+    c3.m_magnitude.Multiply( 5 );
+    helpers::SubtructSigned( c3, p );
+    helpers::SubtructSigned( c3, q );
+    helpers::DivideSignedExact( c3, 3 );
+
+    helpers::SignedNumber c1 = std::move( q );
+    helpers::SubtructSigned( c1, c3 );
+    helpers::DivideSignedExact( c1, 5 );
+
+    helpers::SignedNumber c5 = std::move( p );
+    helpers::SubtructSigned( c5, c3 );
+    helpers::DivideSignedExact( c5, 5 );
+
+    // All coefficients of the product are non negative.
+    SimpleBigNum* coefficients[] = {
+        &values[ 0 ].m_magnitude, &c1.m_magnitude, &c2.m_magnitude, &c3.m_magnitude, &c4.m_magnitude, &c5.m_magnitude, &values[ 6 ].m_magnitude };
+    SimpleBigNum result = std::move( *coefficients[ 6 ] );
+    for( uint32_t coefficientIdx = 6; coefficientIdx > 0; --coefficientIdx )
+    {
+        result.ShiftLeftLimbs( partSize );
+        result.Add( *coefficients[ coefficientIdx - 1 ] );
     }
-    return dstNumber;
+
+    result.RemoveLeadingZeros();
+    *this = std::move( result );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::MultiplyImpl_Ntt( const SimpleBigNum& other )
+{
+    // Multiplication using number theoretic transform, see NttMultiplier.
+    // Time complexity: O( n*log(n) )
+    const uint32_t thisSize = GetNumberOfLimbs();
+    const uint32_t otherSize = other.GetNumberOfLimbs();
+
+    TLimbs newNumber( GetAllocator() );
+    newNumber.Resize( thisSize + otherSize );
+    if( &other == this )
+        sbn::internal::NttMultiplier::Square( m_numberLittleEndian.Data(), thisSize, newNumber.Data() );
+    else
+        sbn::internal::NttMultiplier::Multiply( m_numberLittleEndian.Data(), thisSize, other.m_numberLittleEndian.Data(), otherSize, newNumber.Data() );
+
+    std::swap( m_numberLittleEndian, newNumber );
+    RemoveLeadingZeros();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::SquareImpl()
+{
+    const uint32_t limbs = GetNumberOfLimbs();
+
+    if( limbs < helpers::KARATSUBA_SQUARE_THRESHOLD )
+        return SquareImpl_Basecase();
+
+    if( limbs >= helpers::NTT_SQUARE_THRESHOLD )
+        return MultiplyImpl_Ntt( *this );
+
+    if( limbs >= helpers::TOOM4_SQUARE_THRESHOLD )
+        return MultiplyImpl_Toom4( *this );
+
+    if( limbs >= helpers::TOOM3_SQUARE_THRESHOLD )
+        return MultiplyImpl_Toom3( *this );
+
+    SquareImpl_Karatsuba();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::SquareImpl_Basecase()
+{
+    const uint32_t thisSize = GetNumberOfLimbs();
+
+    TLimbs newNumber( GetAllocator() );
+    newNumber.Resize( 2 * thisSize );
+    sbn::internal::SquareInplaceImpl( m_numberLittleEndian.Data(), thisSize, newNumber.Data() );
+    std::swap( m_numberLittleEndian, newNumber );
+    RemoveLeadingZeros();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleBigNum::SquareImpl_Karatsuba()
+{
+    // Karatsuba method for squaring, see KaratsubaMultiplier. All three products are squares again.
+    const uint32_t thisSize = GetNumberOfLimbs();
+
+    TLimbs newNumber( GetAllocator() );
+    newNumber.Resize( 2 * thisSize );
+    TLimbs scratch( GetAllocator() );
+    scratch.Resize( internal::KaratsubaMultiplier::GetSquareScratchSize( thisSize ) );
+    internal::KaratsubaMultiplier::Square( m_numberLittleEndian.Data(), thisSize, newNumber.Data(), scratch.Data() );
+
+    std::swap( m_numberLittleEndian, newNumber );
+    RemoveLeadingZeros();
 }
 }
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "decimalConverter.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include "../arithmeticImpl/arithmeticImpl.h"
+
+namespace sbn
+{
+namespace internal
+{
+
+namespace helpers
+{
+
+// Numbers up to that many limbs are converted by repeated division by the chunk base.
+constexpr static uint32_t TO_STRING_BASECASE_THRESHOLD = 20;
+// Strings up to that many chunks are parsed by repeated multiplication by the chunk base.
+constexpr static uint32_t FROM_STRING_BASECASE_THRESHOLD = 80;
+// Numbers have less then 2^32 limbs, so less then DECIMAL_CHUNK_DIGITS * 2^33 decimal digits and levels of used powers are below 33.
+constexpr static uint32_t MAX_POWERS_OF_TEN = 40;
+
+// Powers 10^( DECIMAL_CHUNK_DIGITS * 2^level ) indexed by level. Powers are computed under the lock and published by increasing
+// m_numberOfPowers, so powers, that are already published, are read without locking.
+// [NOTE]: Cache keeps powers up to the size of the longest converted number until the end of the program.
+struct PowersOfTenCache
+{
+    std::mutex m_mutex;
+    std::atomic< uint32_t > m_numberOfPowers{ 0 };
+    SimpleBigNum m_powers[ MAX_POWERS_OF_TEN ];
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static PowersOfTenCache& GetPowersOfTenCache()
+{
+    // [NOTE]: Numbers of the cache take the allocator during construction of the cache, so the allocator is destroyed after the cache.
+    static PowersOfTenCache cache;
+    return cache;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Parses up to DECIMAL_CHUNK_DIGITS decimal digits.
+static uint64_t ReadChunk( const char* digits, size_t numberOfDigits )
+{
+    uint64_t chunk = 0;
+    for( size_t i = 0; i < numberOfDigits; ++i )
+        chunk = chunk * 10 + ( uint64_t )( digits[ i ] - '0' );
+
+    return chunk;
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::string DecimalConverter::ToString( const SimpleBigNum& number )
+{
+    if( number.IsZero() )
+        return "0";
+
+    // Number of bits times log10(2) ( approximated by 1234 / 4096 from above ) bounds the number of decimal digits.
+    const uint64_t maxDigits = ( ( uint64_t )number.GetNumberOfBits() * 1234 >> 12 ) + 1;
+    uint32_t level = 0;
+    while( ( ( uint64_t )DECIMAL_CHUNK_DIGITS << level ) < maxDigits )
+        ++level;
+
+    std::string digits( ( size_t )DECIMAL_CHUNK_DIGITS << level, '0' );
+    SimpleBigNum numberCopy = number;
+    WriteDigits( numberCopy, level, &digits[ 0 ] );
+
+    const size_t firstDigitIdx = digits.find_first_not_of( '0' );
+    digits.erase( 0, firstDigitIdx );
+    return digits;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool DecimalConverter::FromString( const std::string& digits, SimpleBigNum& out_number )
+{
+    if( digits.empty() || !IsDecimalStringImpl( digits.data(), digits.size() ) )
+    {
+        out_number.SetZero();
+        return false;
+    }
+
+    ReadDigits( digits.data(), digits.size(), out_number );
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const SimpleBigNum& DecimalConverter::GetPowerOfTen( uint32_t level )
+{
+    helpers::PowersOfTenCache& cache = helpers::GetPowersOfTenCache();
+    if( level < cache.m_numberOfPowers.load( std::memory_order_acquire ) )
+        return cache.m_powers[ level ];
+
+    std::lock_guard< std::mutex > lock( cache.m_mutex );
+    uint32_t numberOfPowers = cache.m_numberOfPowers.load( std::memory_order_relaxed );
+    if( numberOfPowers == 0 )
+    {
+        cache.m_powers[ 0 ] = DECIMAL_CHUNK_BASE;
+        cache.m_numberOfPowers.store( ++numberOfPowers, std::memory_order_release );
+    }
+
+    while( numberOfPowers <= level )
+    {
+        SimpleBigNum& power = cache.m_powers[ numberOfPowers ];
+        power = cache.m_powers[ numberOfPowers - 1 ];
+        power.Square();
+        cache.m_numberOfPowers.store( ++numberOfPowers, std::memory_order_release );
+    }
+
+    return cache.m_powers[ level ];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void DecimalConverter::WriteDigits( SimpleBigNum& number, uint32_t level, char* out_digits )
+{
+    const size_t numberOfDigits = ( size_t )DECIMAL_CHUNK_DIGITS << level;
+    if( number.IsZero() )
+    {
+        memset( out_digits, '0', numberOfDigits );
+        return;
+    }
+
+    if( level == 0 || number.GetNumberOfLimbs() <= helpers::TO_STRING_BASECASE_THRESHOLD )
+    {
+        WriteDigits_Basecase( number, 1u << level, out_digits );
+        return;
+    }
+
+    // Number = high * 10^( DECIMAL_CHUNK_DIGITS * 2^( level - 1 ) ) + low, where both parts take half of the digits.
+    SimpleBigNum high;
+    SimpleBigNum low;
+    number.DivMod( GetPowerOfTen( level - 1 ), high, low );
+    number.SetZero();
+
+    WriteDigits( high, level - 1, out_digits );
+    WriteDigits( low, level - 1, out_digits + numberOfDigits / 2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void DecimalConverter::WriteDigits_Basecase( SimpleBigNum& number, uint32_t numberOfChunks, char* out_digits )
+{
+    // Every chunk takes at least 63 bits of the number, so there are at most one more chunks then limbs.
+    // Chunks are produced from the least significant one.
+    uint64_t chunks[ helpers::TO_STRING_BASECASE_THRESHOLD + 1 ];
+    uint64_t* limbs = number.m_numberLittleEndian.Data();
+    uint32_t size = number.GetNumberOfLimbs();
+    uint32_t chunksSize = 0;
+    while( size > 0 )
+    {
+        chunks[ chunksSize++ ] = DivideByDigitInplaceImpl( limbs, size, DECIMAL_CHUNK_BASE );
+        if( limbs[ size - 1 ] == 0 )
+            --size;
+    }
+
+    std::reverse( chunks, chunks + chunksSize );
+    const size_t leadingZeros = ( size_t )( numberOfChunks - chunksSize ) * DECIMAL_CHUNK_DIGITS;
+    memset( out_digits, '0', leadingZeros );
+    WriteDecimalChunksImpl( chunks, chunksSize, out_digits + leadingZeros );
+    number.SetZero();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void DecimalConverter::ReadDigits( const char* digits, size_t numberOfDigits, SimpleBigNum& out_number )
+{
+    if( numberOfDigits <= ( size_t )DECIMAL_CHUNK_DIGITS * helpers::FROM_STRING_BASECASE_THRESHOLD )
+    {
+        ReadDigits_Basecase( digits, numberOfDigits, out_number );
+        return;
+    }
+
+    // Number = high * 10^( DECIMAL_CHUNK_DIGITS * 2^level ) + low, where low part takes at least half of the digits.
+    uint32_t level = 0;
+    while( ( ( size_t )DECIMAL_CHUNK_DIGITS << ( level + 1 ) ) < numberOfDigits )
+        ++level;
+
+    const size_t lowDigits = ( size_t )DECIMAL_CHUNK_DIGITS << level;
+    SimpleBigNum low;
+    ReadDigits( digits + numberOfDigits - lowDigits, lowDigits, low );
+    ReadDigits( digits, numberOfDigits - lowDigits, out_number );
+
+    out_number.Multiply( GetPowerOfTen( level ) );
+    out_number.Add( low );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void DecimalConverter::ReadDigits_Basecase( const char* digits, size_t numberOfDigits, SimpleBigNum& out_number )
+{
+    // Every chunk fits into a single limb, so the number of chunks bounds the size of the number. The first chunk is shorter,
+    // so that the others are complete.
+    const size_t numberOfChunks = ( numberOfDigits + DECIMAL_CHUNK_DIGITS - 1 ) / DECIMAL_CHUNK_DIGITS;
+    const size_t firstChunkDigits = numberOfDigits - ( numberOfChunks - 1 ) * DECIMAL_CHUNK_DIGITS;
+
+    out_number.m_numberLittleEndian.Resize( numberOfChunks );
+    out_number.m_numberLittleEndian.SetZero();
+    uint64_t* limbs = out_number.m_numberLittleEndian.Data();
+    limbs[ 0 ] = helpers::ReadChunk( digits, firstChunkDigits );
+    uint32_t size = 1;
+
+    uint64_t chunks[ helpers::FROM_STRING_BASECASE_THRESHOLD ];
+    const uint32_t fullChunks = ( uint32_t )numberOfChunks - 1;
+    ReadDecimalChunksImpl( digits + firstChunkDigits, fullChunks, chunks );
+    for( uint32_t chunkIdx = 0; chunkIdx < fullChunks; ++chunkIdx )
+    {
+        // Result is less then B^( size + 1 ), so adding both carries does not overflow.
+        uint64_t carry = MultiplyByDigitInplaceImpl( limbs, size, DECIMAL_CHUNK_BASE );
+        carry += AddDigitInplaceImpl( limbs, size, chunks[ chunkIdx ] );
+        if( carry != 0 )
+            limbs[ size++ ] = carry;
+    }
+
+    out_number.RemoveLeadingZeros();
+}
+
+}
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include "../../include/bigNum.h"
+
+namespace sbn
+{
+namespace internal
+{
+
+// Class converts numbers to and from decimal strings. Long numbers are split recursively by powers 10^( 19 * 2^k ) using the fast
+// division and long strings are combined by multiplication with the same powers, so the cost is O( M(n) * log(n) ) both ways.
+// Short parts are converted by single limb division or multiplication by 10^19, which handles 19 decimal digits at once.
+// Powers of ten are computed once per process, cached and shared by all conversions ( and threads ). Chunks of 19 digits are parsed
+// and formatted by the simd kernels of arithmeticImpl.
+class DecimalConverter
+{
+public:
+    // Returns decimal representation of the number without leading zeros.
+    static std::string ToString( const SimpleBigNum& number );
+
+    // Parses decimal digits to out_number. Returns false and sets out_number to zero, if the string is empty or contains
+    // characters other then decimal digits.
+    static bool FromString( const std::string& digits, SimpleBigNum& out_number );
+
+private:
+    // Returns 10^( DECIMAL_CHUNK_DIGITS * 2^level ) from the shared cache. Missing powers are computed by squaring.
+    // Returned reference stays valid until the end of the program.
+    static const SimpleBigNum& GetPowerOfTen( uint32_t level );
+
+    // Writes exactly DECIMAL_CHUNK_DIGITS * 2^level decimal digits of number ( padded with leading zeros ) to out_digits.
+    // Number has to be less then 10^( DECIMAL_CHUNK_DIGITS * 2^level ). Number is destroyed.
+    static void WriteDigits( SimpleBigNum& number, uint32_t level, char* out_digits );
+
+    // Writes exactly numberOfChunks * DECIMAL_CHUNK_DIGITS decimal digits of number using repeated division by 10^DECIMAL_CHUNK_DIGITS.
+    // Time complexity: O( n^2 ). Number is destroyed.
+    static void WriteDigits_Basecase( SimpleBigNum& number, uint32_t numberOfChunks, char* out_digits );
+
+    // Parses numberOfDigits decimal digits to out_number. Digits have to be valid.
+    static void ReadDigits( const char* digits, size_t numberOfDigits, SimpleBigNum& out_number );
+
+    // Parses numberOfDigits decimal digits to out_number by repeated multiplication by 10^DECIMAL_CHUNK_DIGITS. Digits have to be valid.
+    // Time complexity: O( n^2 ).
+    static void ReadDigits_Basecase( const char* digits, size_t numberOfDigits, SimpleBigNum& out_number );
+};
+
+}
+}
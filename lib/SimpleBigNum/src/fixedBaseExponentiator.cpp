@@ -0,0 +1,141 @@
+#include "../include/fixedBaseExponentiator.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include "modularMultiplier/modularMultiplier.h"
+
+namespace sbn
+{
+namespace helpers
+{
+
+// Bigger windows are never worth it, table of 2^MAX_WINDOW_SIZE multiplications would dominate.
+constexpr static uint32_t MAX_WINDOW_SIZE = 16;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+FixedBaseExponentiator::FixedBaseExponentiator( const SimpleBigNum& base, const SimpleBigNum& modulus, uint32_t maxExponentBits )
+    : m_base( base )
+    , m_modulus( modulus )
+{
+    if( m_modulus.IsZero() || m_modulus.IsOne() )
+        return;
+
+    m_multiplier.reset( new internal::ModularMultiplier( m_modulus ) );
+
+    // Exponentiation costs one multiplication per window and 2^windowSize multiplications to combine them.
+    uint32_t bestCost = UINT32_MAX;
+    for( uint32_t windowSize = 1; windowSize <= helpers::MAX_WINDOW_SIZE; ++windowSize )
+    {
+        const uint32_t cost = ( maxExponentBits + windowSize - 1 ) / windowSize + ( 1u << windowSize );
+        if( cost < bestCost )
+        {
+            bestCost = cost;
+            m_windowSize = windowSize;
+        }
+    }
+
+    const uint32_t numberOfWindows = std::max( 1u, ( maxExponentBits + m_windowSize - 1 ) / m_windowSize );
+    m_powers.resize( numberOfWindows );
+    m_powers[ 0 ] = m_base;
+    m_multiplier->ToInternalForm( m_powers[ 0 ] );
+    for( uint32_t i = 1; i < numberOfWindows; ++i )
+    {
+        m_powers[ i ] = m_powers[ i - 1 ];
+        for( uint32_t j = 0; j < m_windowSize; ++j )
+            m_multiplier->SqrMod( m_powers[ i ] );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+FixedBaseExponentiator::~FixedBaseExponentiator() = default;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const SimpleBigNum& FixedBaseExponentiator::GetModulus() const
+{
+    return m_modulus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void FixedBaseExponentiator::PowMod( const SimpleBigNum& exponent, SimpleBigNum& out_result ) const
+{
+    if( !m_multiplier )
+    {
+        out_result.SetZero();
+        return;
+    }
+
+    if( exponent.IsZero() )
+    {
+        out_result.SetOne();
+        return;
+    }
+
+    const uint32_t numberOfWindows = ( exponent.GetNumberOfBits() + m_windowSize - 1 ) / m_windowSize;
+    if( numberOfWindows > m_powers.size() )
+    {
+        out_result = m_base;
+        out_result.PowMod( exponent, m_modulus );
+        return;
+    }
+
+    // Yao's method: result = product of partialProduct(d) over digits d from the highest one, where partialProduct(d)
+    // is product of powers of all windows with digit at least d. Every window is multiplied once and every digit value once.
+    // Window indices are bucketed by their digit ( counting sort ), so every digit value visits only its own windows.
+    const uint32_t numberOfDigitValues = 1u << m_windowSize;
+    std::vector< uint32_t > digits( numberOfWindows );
+    std::vector< uint32_t > bucketBegins( numberOfDigitValues + 1, 0 );
+    for( uint32_t i = 0; i < numberOfWindows; ++i )
+    {
+        digits[ i ] = ( uint32_t )exponent.GetBits( i * m_windowSize, m_windowSize );
+        ++bucketBegins[ digits[ i ] + 1 ];
+    }
+
+    for( uint32_t digit = 1; digit <= numberOfDigitValues; ++digit )
+        bucketBegins[ digit ] += bucketBegins[ digit - 1 ];
+
+    std::vector< uint32_t > windowsByDigit( numberOfWindows );
+    std::vector< uint32_t > bucketEnds( bucketBegins.begin(), bucketBegins.end() - 1 );
+    for( uint32_t i = 0; i < numberOfWindows; ++i )
+        windowsByDigit[ bucketEnds[ digits[ i ] ]++ ] = i;
+
+    SimpleBigNum partialProduct;
+    SimpleBigNum result;
+    bool isPartialProductSet = false;
+    bool isResultSet = false;
+    for( uint32_t digit = numberOfDigitValues - 1; digit > 0; --digit )
+    {
+        for( uint32_t j = bucketBegins[ digit ]; j < bucketBegins[ digit + 1 ]; ++j )
+        {
+            const uint32_t i = windowsByDigit[ j ];
+            if( isPartialProductSet )
+            {
+                m_multiplier->MulMod( partialProduct, m_powers[ i ] );
+            }
+            else
+            {
+                partialProduct = m_powers[ i ];
+                isPartialProductSet = true;
+            }
+        }
+
+        if( !isPartialProductSet )
+            continue;
+
+        if( isResultSet )
+        {
+            m_multiplier->MulMod( result, partialProduct );
+        }
+        else
+        {
+            result = partialProduct;
+            isResultSet = true;
+        }
+    }
+
+    m_multiplier->FromInternalForm( result );
+    out_result = std::move( result );
+}
+
+}
@@ -0,0 +1,554 @@
+#include "gcdCalculator.h"
+#include <algorithm>
+#include <utility>
+#include "../arithmeticImpl/digitOps.h"
+
+namespace sbn
+{
+namespace internal
+{
+
+namespace helpers
+{
+
+// Numbers at least that long ( in limbs ) are halved by recursion instead of Lehmer's steps.
+constexpr static uint32_t HALF_GCD_THRESHOLD = 200;
+// Gcd reduces numbers at least that long ( in limbs ) using half-gcd of their top third.
+constexpr static uint32_t GCD_HALF_GCD_THRESHOLD = 600;
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Subtructs two limb number ( subHigh, subLow ) from ( high, low ). Result cannot be negative.
+static void SubtructDouble( uint64_t& high, uint64_t& low, uint64_t subHigh, uint64_t subLow )
+{
+    const uint8_t borrow = SubtructDigitsWithBorrow( 0, low, subLow, low );
+    SubtructDigitsWithBorrow( borrow, high, subHigh, high );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Returns true if two limb number ( aHigh, aLow ) is greater or equal to ( bHigh, bLow ).
+static bool IsGreaterOrEqualDouble( uint64_t aHigh, uint64_t aLow, uint64_t bHigh, uint64_t bLow )
+{
+    return aHigh > bHigh || ( aHigh == bHigh && aLow >= bLow );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Divides two limb number ( high, low ) by ( divisorHigh, divisorLow ), which is not zero. Replaces the number with the remainder
+// and returns the quotient. Quotients of Lehmer's steps are usually small, so they are calculated bit by bit.
+static uint64_t DivideDouble( uint64_t& high, uint64_t& low, uint64_t divisorHigh, uint64_t divisorLow )
+{
+    uint32_t shift = 0;
+    while( ( divisorHigh >> 63 ) == 0 && IsGreaterOrEqualDouble( high, low, divisorHigh, divisorLow ) )
+    {
+        divisorHigh = ( divisorHigh << 1 ) | ( divisorLow >> 63 );
+        divisorLow <<= 1;
+        ++shift;
+    }
+
+    uint64_t quotient = 0;
+    for( uint32_t step = 0; step <= shift; ++step )
+    {
+        quotient <<= 1;
+        if( IsGreaterOrEqualDouble( high, low, divisorHigh, divisorLow ) )
+        {
+            SubtructDouble( high, low, divisorHigh, divisorLow );
+            quotient |= 1;
+        }
+
+        divisorLow = ( divisorLow >> 1 ) | ( divisorHigh << 63 );
+        divisorHigh >>= 1;
+    }
+
+    return quotient;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Adds quotient times column of the reduced number to the column of the other one.
+static void AddColumn( uint64_t ( &matrix )[ 2 ][ 2 ], uint32_t reducedIdx, uint64_t quotient )
+{
+    matrix[ 0 ][ 1 - reducedIdx ] += quotient * matrix[ 0 ][ reducedIdx ];
+    matrix[ 1 ][ 1 - reducedIdx ] += quotient * matrix[ 1 ][ reducedIdx ];
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Runs Euclid's algorithm on two limb approximations of numbers a and b, as long as quotients are surely the same
+// as of the whole numbers, and stores the reduction matrix. Returns false, if no quotient is known.
+// Approximations are reduced by subtraction first, so quotients of the whole numbers are known as long as
+// the remainders are not smaller then square root of the approximations ( Jebelean's condition ).
+// When the numbers fit into half of the limbs, they continue with single limb approximations.
+static bool ReduceTopLimbs( uint64_t aHigh, uint64_t aLow, uint64_t bHigh, uint64_t bLow, uint64_t ( &out_matrix )[ 2 ][ 2 ] )
+{
+    constexpr uint64_t HALF_LIMB = ( uint64_t )1 << ( DIGIT_BITS / 2 );
+    constexpr uint64_t SINGLE_LIMB_MIN_REMAINDER = ( uint64_t )1 << ( DIGIT_BITS / 2 + 1 );
+
+    if( aHigh < 2 || bHigh < 2 )
+        return false;
+
+    uint64_t high[ 2 ] = { aHigh, bHigh };
+    uint64_t low[ 2 ] = { aLow, bLow };
+    out_matrix[ 0 ][ 0 ] = 1;
+    out_matrix[ 0 ][ 1 ] = 0;
+    out_matrix[ 1 ][ 0 ] = 0;
+    out_matrix[ 1 ][ 1 ] = 1;
+
+    uint32_t reducedIdx = ( aHigh > bHigh || ( aHigh == bHigh && aLow > bLow ) ) ? 0 : 1;
+    SubtructDouble( high[ reducedIdx ], low[ reducedIdx ], high[ 1 - reducedIdx ], low[ 1 - reducedIdx ] );
+    if( high[ reducedIdx ] < 2 )
+        return false;
+
+    AddColumn( out_matrix, reducedIdx, 1 );
+
+    // Every iteration reduces the number with bigger high limb by the other one.
+    reducedIdx = high[ 0 ] < high[ 1 ] ? 1 : 0;
+    bool isDoubleLimb = true;
+    for( ;; )
+    {
+        const uint32_t otherIdx = 1 - reducedIdx;
+        if( isDoubleLimb )
+        {
+            if( high[ reducedIdx ] == high[ otherIdx ] )
+                break;
+
+            if( high[ reducedIdx ] < HALF_LIMB )
+            {
+                // Top halves of the low limbs are enough from now on.
+                for( uint32_t i = 0; i < 2; ++i )
+                    high[ i ] = ( high[ i ] << ( DIGIT_BITS / 2 ) ) + ( low[ i ] >> ( DIGIT_BITS / 2 ) );
+                isDoubleLimb = false;
+                continue;
+            }
+
+            SubtructDouble( high[ reducedIdx ], low[ reducedIdx ], high[ otherIdx ], low[ otherIdx ] );
+            if( high[ reducedIdx ] < 2 )
+                break;
+
+            if( high[ reducedIdx ] <= high[ otherIdx ] )
+            {
+                AddColumn( out_matrix, reducedIdx, 1 );
+            }
+            else
+            {
+                const uint64_t quotient = DivideDouble( high[ reducedIdx ], low[ reducedIdx ], high[ otherIdx ], low[ otherIdx ] );
+                if( high[ reducedIdx ] < 2 )
+                {
+                    // Remainder is too small, but the quotient is correct.
+                    AddColumn( out_matrix, reducedIdx, quotient );
+                    break;
+                }
+
+                AddColumn( out_matrix, reducedIdx, quotient + 1 );
+            }
+        }
+        else
+        {
+            high[ reducedIdx ] -= high[ otherIdx ];
+            if( high[ reducedIdx ] < SINGLE_LIMB_MIN_REMAINDER )
+                break;
+
+            if( high[ reducedIdx ] <= high[ otherIdx ] )
+            {
+                AddColumn( out_matrix, reducedIdx, 1 );
+            }
+            else
+            {
+                const uint64_t quotient = high[ reducedIdx ] / high[ otherIdx ];
+                high[ reducedIdx ] %= high[ otherIdx ];
+                if( high[ reducedIdx ] < SINGLE_LIMB_MIN_REMAINDER )
+                {
+                    // Remainder is too small, but the quotient is correct.
+                    AddColumn( out_matrix, reducedIdx, quotient );
+                    break;
+                }
+
+                AddColumn( out_matrix, reducedIdx, quotient + 1 );
+            }
+        }
+
+        reducedIdx = otherIdx;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static uint64_t GcdDigits( uint64_t a, uint64_t b )
+{
+    while( b != 0 )
+    {
+        const uint64_t remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+
+    return a;
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleBigNum GcdCalculator::Gcd( const SimpleBigNum& a, const SimpleBigNum& b )
+{
+    SimpleBigNum reducedA = a;
+    SimpleBigNum reducedB = b;
+    Reduce( reducedA, reducedB, nullptr );
+    return reducedA.IsZero() ? reducedB : reducedA;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleBigNum GcdCalculator::ExtendedGcd( const SimpleBigNum& a, const SimpleBigNum& b, SimpleBigNum& out_x, SimpleBigNum* out_y )
+{
+    // Cofactors are the second row of the reduction matrix, so b = m10 * a' + m11 * b'.
+    Row cofactors;
+    cofactors.m_0.SetZero();
+    cofactors.m_1.SetOne();
+    SimpleBigNum reducedA = a;
+    SimpleBigNum reducedB = b;
+    Reduce( reducedA, reducedB, &cofactors );
+
+    // Inverse of the matrix gives a' = m11 * a - m01 * b and b' = m00 * b - m10 * a, so x = m11 if a' is the gcd and x = -m10
+    // if b' is. Both are taken modulo b / gcd into range [ 1, b / gcd ], which keeps y = ( a * x - gcd ) / b non-negative.
+    const bool isGcdInA = !reducedA.IsZero();
+    SimpleBigNum gcd = isGcdInA ? std::move( reducedA ) : std::move( reducedB );
+    SimpleBigNum reducedModulus = b;
+    reducedModulus.Divide( gcd );
+
+    SimpleBigNum x;
+    if( isGcdInA )
+    {
+        x = cofactors.m_1;
+        x.Subtruct( 1 );
+        x.Mod( reducedModulus );
+        x.Add( 1 );
+    }
+    else
+    {
+        cofactors.m_0.Mod( reducedModulus );
+        x = reducedModulus;
+        x.Subtruct( cofactors.m_0 );
+    }
+
+    if( out_y != nullptr )
+    {
+        SimpleBigNum y = a;
+        y.Multiply( x );
+        y.Subtruct( gcd );
+        y.Divide( b );
+        *out_y = std::move( y );
+    }
+
+    out_x = std::move( x );
+    return gcd;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void GcdCalculator::Reduce( SimpleBigNum& a, SimpleBigNum& b, Row* cofactors )
+{
+    Matrix matrix;
+    Matrix1 matrix1;
+    SimpleBigNum quotient;
+    bool isAReduced = false;
+
+    while( !a.IsZero() && !b.IsZero() )
+    {
+        // Half-gcd is useless, if the smaller number does not reach the top part.
+        const uint32_t size = std::max( a.GetNumberOfLimbs(), b.GetNumberOfLimbs() );
+        const uint32_t topPartOffset = 2 * size / 3;
+        if( size >= helpers::GCD_HALF_GCD_THRESHOLD && std::min( a.GetNumberOfLimbs(), b.GetNumberOfLimbs() ) > topPartOffset &&
+            HalfGcdReduce( a, b, topPartOffset, matrix ) )
+        {
+            if( cofactors != nullptr )
+                MultiplyRow( *cofactors, matrix );
+            continue;
+        }
+
+        if( size == 1 && cofactors == nullptr )
+        {
+            a = helpers::GcdDigits( a.m_numberLittleEndian.Front(), b.m_numberLittleEndian.Front() );
+            b.SetZero();
+            break;
+        }
+
+        if( size >= 2 && LehmerStep( a, b, true, matrix1 ) )
+        {
+            ApplyInverseMatrix( a, b, matrix1 );
+            if( cofactors != nullptr )
+                MultiplyRow( *cofactors, matrix1 );
+            continue;
+        }
+
+        DivisionStep( a, b, 0, quotient, isAReduced );
+        if( cofactors != nullptr )
+            MultiplyRow( *cofactors, quotient, isAReduced );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool GcdCalculator::HalfGcd( SimpleBigNum& a, SimpleBigNum& b, Matrix& out_matrix )
+{
+    out_matrix.m_rows[ 0 ].m_0.SetOne();
+    out_matrix.m_rows[ 0 ].m_1.SetZero();
+    out_matrix.m_rows[ 1 ].m_0.SetZero();
+    out_matrix.m_rows[ 1 ].m_1.SetOne();
+
+    const uint32_t size = std::max( a.GetNumberOfLimbs(), b.GetNumberOfLimbs() );
+    const uint32_t s = size / 2 + 1;
+    if( size <= s )
+        return false;
+
+    // Half-gcd of the top half reduces the numbers to about 3/4 of their size, Lehmer's steps continue down to 3/4 and half-gcd
+    // of the top part reduces them to about half. Every reduction stops above B^s, so the matrices of the top parts are valid
+    // for the whole numbers too.
+    bool isReduced = false;
+    if( size >= helpers::HALF_GCD_THRESHOLD )
+    {
+        isReduced = HalfGcdReduce( a, b, size / 2, out_matrix );
+
+        const uint32_t threeQuartersSize = 3 * size / 4 + 1;
+        while( std::max( a.GetNumberOfLimbs(), b.GetNumberOfLimbs() ) > threeQuartersSize )
+        {
+            if( !HalfGcdStep( a, b, s, out_matrix ) )
+                return isReduced;
+            isReduced = true;
+        }
+
+        const uint32_t reducedSize = std::max( a.GetNumberOfLimbs(), b.GetNumberOfLimbs() );
+        if( reducedSize > s + 2 )
+        {
+            Matrix matrix;
+            if( HalfGcdReduce( a, b, 2 * s - reducedSize + 1, matrix ) )
+            {
+                MultiplyRow( out_matrix.m_rows[ 0 ], matrix );
+                MultiplyRow( out_matrix.m_rows[ 1 ], matrix );
+                isReduced = true;
+            }
+        }
+    }
+
+    while( HalfGcdStep( a, b, s, out_matrix ) )
+        isReduced = true;
+
+    return isReduced;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool GcdCalculator::HalfGcdReduce( SimpleBigNum& a, SimpleBigNum& b, uint32_t p, Matrix& out_matrix )
+{
+    const uint32_t aSize = a.GetNumberOfLimbs();
+    const uint32_t bSize = b.GetNumberOfLimbs();
+    const uint64_t* aLimbs = a.m_numberLittleEndian.Data();
+    const uint64_t* bLimbs = b.m_numberLittleEndian.Data();
+
+    SimpleBigNum aTop = p < aSize ? SimpleBigNum( aLimbs + p, aLimbs + aSize ) : SimpleBigNum();
+    SimpleBigNum bTop = p < bSize ? SimpleBigNum( bLimbs + p, bLimbs + bSize ) : SimpleBigNum();
+    if( !HalfGcd( aTop, bTop, out_matrix ) )
+        return false;
+
+    // a' = aTop' * B^p + m11 * aLow - m01 * bLow
+    // b' = bTop' * B^p + m00 * bLow - m10 * aLow
+    const SimpleBigNum aLow( aLimbs, aLimbs + std::min( p, aSize ) );
+    const SimpleBigNum bLow( bLimbs, bLimbs + std::min( p, bSize ) );
+    SimpleBigNum product;
+
+    if( !aTop.IsZero() )
+        aTop.ShiftLeftLimbs( p );
+    product = out_matrix.m_rows[ 1 ].m_1;
+    product.Multiply( aLow );
+    aTop.Add( product );
+    product = out_matrix.m_rows[ 0 ].m_1;
+    product.Multiply( bLow );
+    aTop.Subtruct( product );
+
+    if( !bTop.IsZero() )
+        bTop.ShiftLeftLimbs( p );
+    product = out_matrix.m_rows[ 0 ].m_0;
+    product.Multiply( bLow );
+    bTop.Add( product );
+    product = out_matrix.m_rows[ 1 ].m_0;
+    product.Multiply( aLow );
+    bTop.Subtruct( product );
+
+    a = std::move( aTop );
+    b = std::move( bTop );
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool GcdCalculator::HalfGcdStep( SimpleBigNum& a, SimpleBigNum& b, uint32_t s, Matrix& matrix )
+{
+    // Lehmer's step reduces the numbers by about one limb, so it is not used for numbers just above B^s.
+    const uint32_t size = std::max( a.GetNumberOfLimbs(), b.GetNumberOfLimbs() );
+    const uint64_t aTopLimb = a.GetNumberOfLimbs() == size ? a.m_numberLittleEndian.Back() : 0;
+    const uint64_t bTopLimb = b.GetNumberOfLimbs() == size ? b.m_numberLittleEndian.Back() : 0;
+
+    // Just above B^s the limbs are not shifted, so that the remainders of the approximations stay above B^s.
+    Matrix1 matrix1;
+    const bool isAboveHalf = size > s + 1;
+    if( ( isAboveHalf || ( aTopLimb | bTopLimb ) >= 4 ) && LehmerStep( a, b, isAboveHalf, matrix1 ) )
+    {
+        ApplyInverseMatrix( a, b, matrix1 );
+        MultiplyRow( matrix.m_rows[ 0 ], matrix1 );
+        MultiplyRow( matrix.m_rows[ 1 ], matrix1 );
+        return true;
+    }
+
+    SimpleBigNum quotient;
+    bool isAReduced = false;
+    if( !DivisionStep( a, b, s, quotient, isAReduced ) )
+        return false;
+
+    MultiplyRow( matrix.m_rows[ 0 ], quotient, isAReduced );
+    MultiplyRow( matrix.m_rows[ 1 ], quotient, isAReduced );
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool GcdCalculator::DivisionStep( SimpleBigNum& a, SimpleBigNum& b, uint32_t s, SimpleBigNum& out_quotient, bool& out_isAReduced )
+{
+    out_isAReduced = a.IsGreaterOrEqualTo( b );
+    SimpleBigNum& bigger = out_isAReduced ? a : b;
+    const SimpleBigNum& smaller = out_isAReduced ? b : a;
+    if( s > 0 && smaller.GetNumberOfLimbs() <= s )
+        return false;
+
+    SimpleBigNum remainder;
+    bigger.DivMod( smaller, out_quotient, remainder );
+    if( s > 0 && remainder.GetNumberOfLimbs() <= s )
+    {
+        // Remainder would be smaller then B^s, so the last subtraction is not done.
+        out_quotient.Subtruct( 1 );
+        if( out_quotient.IsZero() )
+            return false;
+
+        remainder.Add( smaller );
+    }
+
+    bigger = std::move( remainder );
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool GcdCalculator::LehmerStep( const SimpleBigNum& a, const SimpleBigNum& b, bool isNormalized, Matrix1& out_matrix )
+{
+    // Three most significant limbs of both numbers, shifted so that the bigger one has the highest bit set.
+    const uint32_t size = std::max( a.GetNumberOfLimbs(), b.GetNumberOfLimbs() );
+    uint64_t aLimbs[ 3 ] = {};
+    uint64_t bLimbs[ 3 ] = {};
+    for( uint32_t i = 0; i < 3 && i < size; ++i )
+    {
+        const uint32_t limbIdx = size - 1 - i;
+        aLimbs[ i ] = limbIdx < a.GetNumberOfLimbs() ? a.m_numberLittleEndian.Data()[ limbIdx ] : 0;
+        bLimbs[ i ] = limbIdx < b.GetNumberOfLimbs() ? b.m_numberLittleEndian.Data()[ limbIdx ] : 0;
+    }
+
+    const uint32_t shift = isNormalized ? CountLeadingZeros( aLimbs[ 0 ] | bLimbs[ 0 ] ) : 0;
+    if( shift != 0 )
+    {
+        for( uint32_t i = 0; i < 2; ++i )
+        {
+            aLimbs[ i ] = ( aLimbs[ i ] << shift ) | ( aLimbs[ i + 1 ] >> ( DIGIT_BITS - shift ) );
+            bLimbs[ i ] = ( bLimbs[ i ] << shift ) | ( bLimbs[ i + 1 ] >> ( DIGIT_BITS - shift ) );
+        }
+    }
+
+    uint64_t matrix[ 2 ][ 2 ];
+    if( !helpers::ReduceTopLimbs( aLimbs[ 0 ], aLimbs[ 1 ], bLimbs[ 0 ], bLimbs[ 1 ], matrix ) )
+        return false;
+
+    out_matrix.m_00 = matrix[ 0 ][ 0 ];
+    out_matrix.m_01 = matrix[ 0 ][ 1 ];
+    out_matrix.m_10 = matrix[ 1 ][ 0 ];
+    out_matrix.m_11 = matrix[ 1 ][ 1 ];
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void GcdCalculator::ApplyInverseMatrix( SimpleBigNum& a, SimpleBigNum& b, const Matrix1& matrix )
+{
+    // a' = m11 * a - m01 * b, b' = m00 * b - m10 * a
+    // Determinant is one, so both results are non-negative and not greater then the numbers. Positive and negative
+    // products are accumulated with separate carries, so the results are computed inplace in a single pass.
+    const uint32_t size = std::max( a.GetNumberOfLimbs(), b.GetNumberOfLimbs() );
+    a.m_numberLittleEndian.Resize( size );
+    b.m_numberLittleEndian.Resize( size );
+    uint64_t* aLimbs = a.m_numberLittleEndian.Data();
+    uint64_t* bLimbs = b.m_numberLittleEndian.Data();
+
+    uint64_t aAddedCarry = 0;
+    uint64_t aSubtructedCarry = 0;
+    uint64_t bAddedCarry = 0;
+    uint64_t bSubtructedCarry = 0;
+    uint8_t aBorrow = 0;
+    uint8_t bBorrow = 0;
+    for( uint32_t i = 0; i < size; ++i )
+    {
+        const uint64_t aLimb = aLimbs[ i ];
+        const uint64_t bLimb = bLimbs[ i ];
+        uint64_t high;
+
+        uint64_t added = MultiplyDigits( matrix.m_11, aLimb, high );
+        aAddedCarry = high + AddDigitsWithCarry( 0, added, aAddedCarry, added );
+        uint64_t subtructed = MultiplyDigits( matrix.m_01, bLimb, high );
+        aSubtructedCarry = high + AddDigitsWithCarry( 0, subtructed, aSubtructedCarry, subtructed );
+        aBorrow = SubtructDigitsWithBorrow( aBorrow, added, subtructed, aLimbs[ i ] );
+
+        added = MultiplyDigits( matrix.m_00, bLimb, high );
+        bAddedCarry = high + AddDigitsWithCarry( 0, added, bAddedCarry, added );
+        subtructed = MultiplyDigits( matrix.m_10, aLimb, high );
+        bSubtructedCarry = high + AddDigitsWithCarry( 0, subtructed, bSubtructedCarry, subtructed );
+        bBorrow = SubtructDigitsWithBorrow( bBorrow, added, subtructed, bLimbs[ i ] );
+    }
+
+    a.RemoveLeadingZeros();
+    b.RemoveLeadingZeros();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void GcdCalculator::MultiplyRow( Row& row, const Matrix1& matrix )
+{
+    // ( r0, r1 ) * M = ( r0 * m00 + r1 * m10, r0 * m01 + r1 * m11 )
+    SimpleBigNum first = row.m_0;
+    first.Multiply( matrix.m_00 );
+    SimpleBigNum product = row.m_1;
+    product.Multiply( matrix.m_10 );
+    first.Add( product );
+
+    SimpleBigNum second = row.m_0;
+    second.Multiply( matrix.m_01 );
+    product = row.m_1;
+    product.Multiply( matrix.m_11 );
+    second.Add( product );
+
+    row.m_0 = std::move( first );
+    row.m_1 = std::move( second );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void GcdCalculator::MultiplyRow( Row& row, const Matrix& matrix )
+{
+    SimpleBigNum first = row.m_0;
+    first.Multiply( matrix.m_rows[ 0 ].m_0 );
+    SimpleBigNum product = row.m_1;
+    product.Multiply( matrix.m_rows[ 1 ].m_0 );
+    first.Add( product );
+
+    SimpleBigNum second = row.m_0;
+    second.Multiply( matrix.m_rows[ 0 ].m_1 );
+    product = row.m_1;
+    product.Multiply( matrix.m_rows[ 1 ].m_1 );
+    second.Add( product );
+
+    row.m_0 = std::move( first );
+    row.m_1 = std::move( second );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void GcdCalculator::MultiplyRow( Row& row, const SimpleBigNum& quotient, bool isAReduced )
+{
+    // a - q * b multiplies M by ( 1 q; 0 1 ) from the right, b - q * a by ( 1 0; q 1 ).
+    SimpleBigNum& updated = isAReduced ? row.m_1 : row.m_0;
+    SimpleBigNum product = isAReduced ? row.m_0 : row.m_1;
+    product.Multiply( quotient );
+    updated.Add( product );
+}
+
+}
+}
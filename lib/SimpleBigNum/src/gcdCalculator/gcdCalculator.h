@@ -0,0 +1,80 @@
+#pragma once
+#include "../../include/bigNum.h"
+
+namespace sbn
+{
+namespace internal
+{
+
+// Class calculates greatest common divisors. Numbers are reduced by Lehmer's steps, which compute quotients of two limb
+// approximations of the numbers and apply them to whole numbers at once. Long numbers are reduced using half-gcd recursion,
+// which halves the numbers using reduction of their top halves, so the cost is O( M(n) * log(n) ).
+class GcdCalculator
+{
+public:
+    // Returns gcd( a, b ). Gcd with zero is the other number.
+    static SimpleBigNum Gcd( const SimpleBigNum& a, const SimpleBigNum& b );
+
+    // Returns gcd( a, b ) and stores coefficients 1 <= x <= b / gcd and y < a / gcd, such that a * x - b * y = gcd.
+    // Out_y can be null, when the coefficient is not needed. A cannot be zero and b cannot be zero.
+    static SimpleBigNum ExtendedGcd( const SimpleBigNum& a, const SimpleBigNum& b, SimpleBigNum& out_x, SimpleBigNum* out_y );
+
+private:
+    // Row of matrix of non-negative numbers.
+    struct Row
+    {
+        SimpleBigNum m_0;
+        SimpleBigNum m_1;
+    };
+
+    // Matrix M of non-negative numbers with determinant one, which reduces numbers a and b to a' and b', such that ( a; b ) = M * ( a'; b' ).
+    struct Matrix
+    {
+        Row m_rows[ 2 ];
+    };
+
+    // Matrix M of single limbs with determinant one, which reduces numbers a and b to a' and b', such that ( a; b ) = M * ( a'; b' ).
+    struct Matrix1
+    {
+        uint64_t m_00 = 1;
+        uint64_t m_01 = 0;
+        uint64_t m_10 = 0;
+        uint64_t m_11 = 1;
+    };
+
+    // Reduces a and b to ( gcd, 0 ) or ( 0, gcd ). If cofactors are not null, they are multiplied by the reduction matrix.
+    static void Reduce( SimpleBigNum& a, SimpleBigNum& b, Row* cofactors );
+
+    // Reduces a and b inplace to a' and b' not smaller then B^s, where s is half of the size of the numbers ( in limbs ).
+    // Stores reduction matrix in out_matrix. Returns false, if numbers could not be reduced.
+    static bool HalfGcd( SimpleBigNum& a, SimpleBigNum& b, Matrix& out_matrix );
+
+    // Reduces a and b inplace using half-gcd of their parts above the lowest p limbs. Stores reduction matrix in out_matrix.
+    // Returns false, if numbers could not be reduced.
+    static bool HalfGcdReduce( SimpleBigNum& a, SimpleBigNum& b, uint32_t p, Matrix& out_matrix );
+
+    // Reduces a and b inplace by single Lehmer's step or division, if both results are not smaller then B^s.
+    // Updates the matrix. Returns false, if numbers could not be reduced.
+    static bool HalfGcdStep( SimpleBigNum& a, SimpleBigNum& b, uint32_t s, Matrix& matrix );
+
+    // Reduces bigger one of a and b modulo the smaller one and stores quotient in out_quotient. If s is not zero, quotient is
+    // decreased, so that the remainder is not smaller then B^s. Returns false, if the number could not be reduced.
+    static bool DivisionStep( SimpleBigNum& a, SimpleBigNum& b, uint32_t s, SimpleBigNum& out_quotient, bool& out_isAReduced );
+
+    // Calculates reduction matrix of a and b based on their two most significant limbs ( aligned to the bigger one, if
+    // isNormalized is true ) as long as quotients are the same as of the whole numbers. Returns false if no quotient is known.
+    static bool LehmerStep( const SimpleBigNum& a, const SimpleBigNum& b, bool isNormalized, Matrix1& out_matrix );
+
+    // Replaces a and b with M^-1 * ( a; b ).
+    static void ApplyInverseMatrix( SimpleBigNum& a, SimpleBigNum& b, const Matrix1& matrix );
+
+    // Multiplies row by matrix.
+    static void MultiplyRow( Row& row, const Matrix1& matrix );
+    static void MultiplyRow( Row& row, const Matrix& matrix );
+
+    // Multiplies row by matrix of reduction of a by quotient * b ( or b by quotient * a ).
+    static void MultiplyRow( Row& row, const SimpleBigNum& quotient, bool isAReduced );
+};
+
+}
+}
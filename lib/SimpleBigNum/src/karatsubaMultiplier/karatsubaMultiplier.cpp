@@ -0,0 +1,236 @@
+#include "karatsubaMultiplier.h"
+#include <algorithm>
+#include <cstring>
+#include "../arithmeticImpl/arithmeticImpl.h"
+#include "../arithmeticImpl/digitOps.h"
+
+namespace sbn
+{
+namespace internal
+{
+
+namespace helpers
+{
+
+// [NOTE]: Simd Add and Subtruct kernels process whole vectors past the end of the numbers, what is not allowed
+// inside shared scratch buffer, so helpers below work on exact sizes.
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Adds other number to the number. Carry is propagated up to numberSize limbs. Returns carry out of the number.
+static uint8_t AddTo( TRawBufferPtr number, uint32_t numberSize, TConstRawBufferPtr other, uint32_t otherSize )
+{
+    uint8_t carry = 0;
+    for( uint32_t idx = 0; idx < otherSize; ++idx )
+        carry = AddDigitsWithCarry( carry, number[ idx ], other[ idx ], number[ idx ] );
+
+    for( uint32_t idx = otherSize; carry != 0 && idx < numberSize; ++idx )
+        carry = AddDigitsWithCarry( carry, number[ idx ], 0, number[ idx ] );
+
+    return carry;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Calculates number = other - number on size limbs. Returns borrow out of the result.
+static uint8_t SubtructReversed( TRawBufferPtr number, TConstRawBufferPtr other, uint32_t size )
+{
+    uint8_t borrow = 0;
+    for( uint32_t idx = 0; idx < size; ++idx )
+        borrow = SubtructDigitsWithBorrow( borrow, other[ idx ], number[ idx ], number[ idx ] );
+
+    return borrow;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Stores |a - b| on aSize limbs in out_result. aSize cannot be less then bSize. Returns true if b is greater then a.
+static bool SubtructAbs( TConstRawBufferPtr a, uint32_t aSize, TConstRawBufferPtr b, uint32_t bSize, TRawBufferPtr out_result )
+{
+    bool isNegative = false;
+    uint32_t idx = aSize;
+    while( idx > bSize && a[ idx - 1 ] == 0 )
+        --idx;
+
+    if( idx == bSize )
+    {
+        while( idx > 0 && a[ idx - 1 ] == b[ idx - 1 ] )
+            --idx;
+        isNegative = ( idx > 0 && a[ idx - 1 ] < b[ idx - 1 ] );
+    }
+
+    if( isNegative )
+    {
+        // a is less then b, so its limbs above bSize are zero.
+        std::swap( a, b );
+        for( uint32_t limbIdx = bSize; limbIdx < aSize; ++limbIdx )
+            out_result[ limbIdx ] = 0;
+    }
+
+    uint8_t borrow = 0;
+    for( uint32_t limbIdx = 0; limbIdx < bSize; ++limbIdx )
+        borrow = SubtructDigitsWithBorrow( borrow, a[ limbIdx ], b[ limbIdx ], out_result[ limbIdx ] );
+
+    if( !isNegative )
+    {
+        for( uint32_t limbIdx = bSize; limbIdx < aSize; ++limbIdx )
+            borrow = SubtructDigitsWithBorrow( borrow, a[ limbIdx ], 0, out_result[ limbIdx ] );
+    }
+
+    return isNegative;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Adds middle coefficient of Karatsuba method to the result at given offset.
+static void AddMiddleCoefficient( TRawBufferPtr result, uint32_t resultSize, uint32_t offset, TConstRawBufferPtr middle, uint32_t middleSize )
+{
+    // Middle coefficient fits into the result, so its limbs, that do not fit, are zero.
+    AddTo( result + offset, resultSize - offset, middle, std::min( middleSize, resultSize - offset ) );
+}
+
+static void MultiplyRecursive( TConstRawBufferPtr a, uint32_t aSize, TConstRawBufferPtr b, uint32_t bSize, TRawBufferPtr out_result, TRawBufferPtr scratch );
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static void MultiplyOrdered( TConstRawBufferPtr a, uint32_t aSize, TConstRawBufferPtr b, uint32_t bSize, TRawBufferPtr out_result, TRawBufferPtr scratch )
+{
+    if( aSize >= bSize )
+        MultiplyRecursive( a, aSize, b, bSize, out_result, scratch );
+    else
+        MultiplyRecursive( b, bSize, a, aSize, out_result, scratch );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static void MultiplyRecursive( TConstRawBufferPtr a, uint32_t aSize, TConstRawBufferPtr b, uint32_t bSize, TRawBufferPtr out_result, TRawBufferPtr scratch )
+{
+    // Karatsuba method with subtractive middle term:
+    // a = a1*B + a0, b = b1*B + b0
+    // z0 = a0 * b0
+    // z2 = a1 * b1
+    // z1 = z0 + z2 - ( a0 - a1 ) * ( b0 - b1 )
+    // result = z2*B*B + z1*B + z0
+    // Differences are not longer then the lower parts, so unlike with sums there are no carries to handle.
+    //
+    // Layout of the buffers:
+    // out_result: | a0 - a1 | b0 - b1 | ... | -> | z0 | z2 |
+    // scratch:    | ( a0 - a1 ) * ( b0 - b1 ), extended to z1 | scratch of the recursion |
+
+    const uint32_t resultSize = aSize + bSize;
+    if( bSize < KaratsubaMultiplier::MULTIPLY_THRESHOLD )
+    {
+        memset( out_result, 0, resultSize * sizeof( TDigitType ) );
+        MultiplyInplaceImpl( a, aSize, b, bSize, out_result );
+        return;
+    }
+
+    const uint32_t lowSize = ( aSize + 1 ) / 2;
+    const uint32_t highSize = aSize - lowSize;
+
+    if( bSize <= lowSize )
+    {
+        // b is too short to be split: result = a1*b*B + a0*b
+        const uint32_t highProductSize = highSize + bSize;
+        MultiplyRecursive( a, lowSize, b, bSize, out_result, scratch );
+        MultiplyOrdered( a + lowSize, highSize, b, bSize, scratch, scratch + highProductSize );
+        memset( out_result + lowSize + bSize, 0, ( resultSize - lowSize - bSize ) * sizeof( TDigitType ) );
+        AddTo( out_result + lowSize, highProductSize, scratch, highProductSize );
+        return;
+    }
+
+    const uint32_t bHighSize = bSize - lowSize;
+    const bool isANegative = SubtructAbs( a, lowSize, a + lowSize, highSize, out_result );
+    const bool isBNegative = SubtructAbs( b, lowSize, b + lowSize, bHighSize, out_result + lowSize );
+
+    const uint32_t middleSize = 2 * lowSize + 1;
+    TRawBufferPtr middle = scratch;
+    TRawBufferPtr nextScratch = scratch + middleSize;
+    MultiplyRecursive( out_result, lowSize, out_result + lowSize, lowSize, middle, nextScratch );
+
+    TRawBufferPtr z0 = out_result;
+    TRawBufferPtr z2 = out_result + 2 * lowSize;
+    const uint32_t z2Size = highSize + bHighSize;
+    MultiplyRecursive( a, lowSize, b, lowSize, z0, nextScratch );
+    MultiplyRecursive( a + lowSize, highSize, b + lowSize, bHighSize, z2, nextScratch );
+
+    middle[ 2 * lowSize ] = 0;
+    if( isANegative == isBNegative )
+    {
+        // z1 = z0 - ( a0 - a1 ) * ( b0 - b1 ) + z2. First difference may be negative, then it is kept
+        // in two's complement form and carry of the following addition cancels the borrow.
+        middle[ 2 * lowSize ] = 0 - ( TDigitType )SubtructReversed( middle, z0, 2 * lowSize );
+    }
+    else
+    {
+        AddTo( middle, middleSize, z0, 2 * lowSize );
+    }
+    AddTo( middle, middleSize, z2, z2Size );
+
+    AddMiddleCoefficient( out_result, resultSize, lowSize, middle, middleSize );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static void SquareRecursive( TConstRawBufferPtr a, uint32_t aSize, TRawBufferPtr out_result, TRawBufferPtr scratch )
+{
+    // Same as multiplication, but all products are squares and z1 = z0 + z2 - ( a0 - a1 )^2 always.
+
+    const uint32_t resultSize = 2 * aSize;
+    if( aSize < KaratsubaMultiplier::SQUARE_THRESHOLD )
+    {
+        memset( out_result, 0, resultSize * sizeof( TDigitType ) );
+        SquareInplaceImpl( a, aSize, out_result );
+        return;
+    }
+
+    const uint32_t lowSize = ( aSize + 1 ) / 2;
+    const uint32_t highSize = aSize - lowSize;
+    SubtructAbs( a, lowSize, a + lowSize, highSize, out_result );
+
+    const uint32_t middleSize = 2 * lowSize + 1;
+    TRawBufferPtr middle = scratch;
+    TRawBufferPtr nextScratch = scratch + middleSize;
+    SquareRecursive( out_result, lowSize, middle, nextScratch );
+
+    TRawBufferPtr z0 = out_result;
+    TRawBufferPtr z2 = out_result + 2 * lowSize;
+    SquareRecursive( a, lowSize, z0, nextScratch );
+    SquareRecursive( a + lowSize, highSize, z2, nextScratch );
+
+    middle[ 2 * lowSize ] = 0 - ( TDigitType )SubtructReversed( middle, z0, 2 * lowSize );
+    AddTo( middle, middleSize, z2, 2 * highSize );
+
+    AddMiddleCoefficient( out_result, resultSize, lowSize, middle, middleSize );
+}
+
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+uint32_t KaratsubaMultiplier::GetMultiplyScratchSize( uint32_t biggerSize )
+{
+    // Every level needs 2 * lowSize + 1 limbs for the middle coefficient and passes the rest to the next one.
+    uint32_t scratchSize = 0;
+    for( uint32_t size = biggerSize; size >= MULTIPLY_THRESHOLD; size = ( size + 1 ) / 2 )
+        scratchSize += 2 * ( ( size + 1 ) / 2 ) + 1;
+
+    return scratchSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+uint32_t KaratsubaMultiplier::GetSquareScratchSize( uint32_t size )
+{
+    uint32_t scratchSize = 0;
+    for( ; size >= SQUARE_THRESHOLD; size = ( size + 1 ) / 2 )
+        scratchSize += 2 * ( ( size + 1 ) / 2 ) + 1;
+
+    return scratchSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void KaratsubaMultiplier::Multiply( TConstRawBufferPtr a, uint32_t aSize, TConstRawBufferPtr b, uint32_t bSize, TRawBufferPtr out_result, TRawBufferPtr scratch )
+{
+    helpers::MultiplyRecursive( a, aSize, b, bSize, out_result, scratch );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void KaratsubaMultiplier::Square( TConstRawBufferPtr a, uint32_t aSize, TRawBufferPtr out_result, TRawBufferPtr scratch )
+{
+    helpers::SquareRecursive( a, aSize, out_result, scratch );
+}
+
+}
+}
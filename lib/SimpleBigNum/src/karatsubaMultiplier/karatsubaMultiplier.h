@@ -0,0 +1,33 @@
+#pragma once
+#include "../arithmeticImpl/typedefs.h"
+
+namespace sbn
+{
+namespace internal
+{
+
+// Class multiplies numbers using Karatsuba method directly on limb buffers.
+// All temporary values live in single scratch buffer provided by the caller, so there are no allocations during the recursion.
+class KaratsubaMultiplier
+{
+public:
+    // Operands shorter then thresholds ( in limbs ) are multiplied using basecase kernels.
+    static constexpr uint32_t MULTIPLY_THRESHOLD = 32;
+    static constexpr uint32_t SQUARE_THRESHOLD = 48;
+
+    // Returns number of limbs of scratch buffer needed to multiply numbers, whose bigger one has biggerSize limbs.
+    // It is about 2 * biggerSize.
+    static uint32_t GetMultiplyScratchSize( uint32_t biggerSize );
+
+    // Returns number of limbs of scratch buffer needed to square number of given size.
+    static uint32_t GetSquareScratchSize( uint32_t size );
+
+    // Multiplies a by b. aSize cannot be less then bSize. Result has to have space for aSize + bSize limbs, it does not have to be zeroed.
+    static void Multiply( TConstRawBufferPtr a, uint32_t aSize, TConstRawBufferPtr b, uint32_t bSize, TRawBufferPtr out_result, TRawBufferPtr scratch );
+
+    // Squares a. Result has to have space for 2 * aSize limbs, it does not have to be zeroed.
+    static void Square( TConstRawBufferPtr a, uint32_t aSize, TRawBufferPtr out_result, TRawBufferPtr scratch );
+};
+
+}
+}
@@ -0,0 +1,67 @@
+#include "modularMultiplier.h"
+
+namespace sbn
+{
+namespace internal
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+ModularMultiplier::ModularMultiplier( const SimpleBigNum& modulus )
+{
+    // Number is odd when its lowest bit is set.
+    if( modulus.GetBits( 0, 1 ) == 1 )
+        m_montgomeryContext.reset( new MontgomeryContext( modulus ) );
+    else
+        m_barrettReducer.reset( new BarrettReducer( modulus ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const SimpleBigNum& ModularMultiplier::GetModulus() const
+{
+    return m_montgomeryContext ? m_montgomeryContext->GetModulus() : m_barrettReducer->GetDivisor();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void ModularMultiplier::ToInternalForm( SimpleBigNum& number ) const
+{
+    if( m_montgomeryContext )
+        m_montgomeryContext->ToMontgomeryForm( number );
+    else if( number.IsGreaterOrEqualTo( m_barrettReducer->GetDivisor() ) )
+        m_barrettReducer->Mod( number );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void ModularMultiplier::FromInternalForm( SimpleBigNum& number ) const
+{
+    if( m_montgomeryContext )
+        m_montgomeryContext->FromMontgomeryForm( number );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void ModularMultiplier::MulMod( SimpleBigNum& number, const SimpleBigNum& other ) const
+{
+    if( m_montgomeryContext )
+    {
+        m_montgomeryContext->MulMod( number, other );
+        return;
+    }
+
+    number.Multiply( other );
+    m_barrettReducer->Mod( number );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void ModularMultiplier::SqrMod( SimpleBigNum& number ) const
+{
+    if( m_montgomeryContext )
+    {
+        m_montgomeryContext->SqrMod( number );
+        return;
+    }
+
+    number.Square();
+    m_barrettReducer->Mod( number );
+}
+
+}
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <memory>
+#include "../../include/bigNum.h"
+#include "../../include/barrettReducer.h"
+#include "../../include/montgomeryContext.h"
+
+namespace sbn
+{
+namespace internal
+{
+
+// Class multiplies numbers modulo fixed modulus in internal form used by modular exponentiation.
+// Odd moduli use Montgomery form, even ones are reduced using Barrett reduction and the internal form is the number itself.
+class ModularMultiplier
+{
+public:
+    // Ctor. Modulus has to be greater then one.
+    explicit ModularMultiplier( const SimpleBigNum& modulus );
+
+    // Returns the modulus.
+    const SimpleBigNum& GetModulus() const;
+
+    // Converts number inplace to the internal form. Number is reduced modulo modulus first.
+    void ToInternalForm( SimpleBigNum& number ) const;
+
+    // Converts number inplace from the internal form back to the normal one.
+    void FromInternalForm( SimpleBigNum& number ) const;
+
+    // Multiplies inplace by other number. Both numbers and the result are in the internal form.
+    void MulMod( SimpleBigNum& number, const SimpleBigNum& other ) const;
+
+    // Squares inplace. Number and the result are in the internal form.
+    void SqrMod( SimpleBigNum& number ) const;
+
+private:
+    // Exactly one of the backends is set.
+    std::unique_ptr< MontgomeryContext > m_montgomeryContext;
+    std::unique_ptr< BarrettReducer > m_barrettReducer;
+};
+
+}
+}
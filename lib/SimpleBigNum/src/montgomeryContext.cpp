@@ -0,0 +1,81 @@
+#include "../include/montgomeryContext.h"
+#include "arithmeticImpl/arithmeticImpl.h"
+
+namespace sbn
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MontgomeryContext::MontgomeryContext( const SimpleBigNum& modulus )
+    : m_modulus( modulus )
+{
+    // Odd x satisfies x * x = 1 mod 8, so x is its own inverse on 3 bits.
+    // Every Newton's step inverse = inverse * ( 2 - x * inverse ) doubles the number of correct bits.
+    const uint64_t modulusLow = m_modulus.m_numberLittleEndian.Front();
+    uint64_t inverse = modulusLow;
+    for( uint32_t step = 0; step < 5; ++step )
+        inverse *= 2 - modulusLow * inverse;
+    m_modulusInverse = 0 - inverse;
+
+    m_rSquared.SetOne();
+    m_rSquared.ShiftLeftLimbs( 2 * m_modulus.GetNumberOfLimbs() );
+    m_rSquared.Mod( m_modulus );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const SimpleBigNum& MontgomeryContext::GetModulus() const
+{
+    return m_modulus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void MontgomeryContext::ToMontgomeryForm( SimpleBigNum& number ) const
+{
+    // number * R = ( number * R^2 ) * R^-1
+    if( number.IsGreaterOrEqualTo( m_modulus ) )
+        number.Mod( m_modulus );
+
+    number.Multiply( m_rSquared );
+    Reduce( number );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void MontgomeryContext::FromMontgomeryForm( SimpleBigNum& number ) const
+{
+    if( number.IsGreaterOrEqualTo( m_modulus ) )
+        number.Mod( m_modulus );
+
+    Reduce( number );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void MontgomeryContext::MulMod( SimpleBigNum& number, const SimpleBigNum& other ) const
+{
+    number.Multiply( other );
+    Reduce( number );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void MontgomeryContext::SqrMod( SimpleBigNum& number ) const
+{
+    number.Square();
+    Reduce( number );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void MontgomeryContext::Reduce( SimpleBigNum& number ) const
+{
+    const uint32_t modulusSize = m_modulus.GetNumberOfLimbs();
+    number.m_numberLittleEndian.Resize( 2 * modulusSize );
+    const auto carry = internal::MontgomeryReduceInplaceImpl( number.m_numberLittleEndian.Data(), m_modulus.m_numberLittleEndian.Data(), modulusSize, m_modulusInverse );
+
+    number.ShiftRightLimbs( modulusSize );
+    if( carry != 0 )
+        number.m_numberLittleEndian.PushBack( carry );
+    number.RemoveLeadingZeros();
+
+    // Reduced number is less then 2 * modulus.
+    if( number.IsGreaterOrEqualTo( m_modulus ) )
+        number.Subtruct( m_modulus );
+}
+
+}
@@ -0,0 +1,316 @@
+#include "nttMultiplier.h"
+#include "../arithmeticImpl/digitOps.h"
+#include <vector>
+
+namespace sbn
+{
+namespace internal
+{
+
+namespace helpers
+{
+
+// Primes of form c*2^k+1 ( 27*2^56+1, 57*2^55+1, 29*2^57+1 ) and their primitive roots.
+// All primes are less then 2^62, so sum of two residues never overflows. Primes are sorted, what simplifies CRT.
+// Product of primes is greater then 2^183, so it holds every convolution coefficient ( sum of up to 2^55 products of two limbs ).
+constexpr uint32_t NUMBER_OF_PRIMES = 3;
+constexpr TDigitType PRIMES[ NUMBER_OF_PRIMES ] = { 1945555039024054273ull, 2053641430080946177ull, 4179340454199820289ull };
+constexpr TDigitType PRIMITIVE_ROOTS[ NUMBER_OF_PRIMES ] = { 5, 7, 3 };
+
+// Values used by Montgomery multiplication modulo given prime. Montgomery form of x is x * 2^64 mod prime.
+struct PrimeContext
+{
+    TDigitType m_prime = 0;
+    TDigitType m_primeInverse = 0;          // prime^-1 mod 2^64
+    TDigitType m_montgomeryOne = 0;         // 2^64 mod prime
+    TDigitType m_montgomeryOneSquared = 0;  // 2^128 mod prime
+    TDigitType m_primitiveRoot = 0;
+};
+
+// Working buffers reused by transforms of all primes.
+struct TransformBuffers
+{
+    std::vector< TDigitType > m_first;
+    std::vector< TDigitType > m_second;
+    std::vector< TDigitType > m_roots;
+    std::vector< TDigitType > m_inverseRoots;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static inline TDigitType AddModulo( TDigitType a, TDigitType b, TDigitType prime )
+{
+    const TDigitType sum = a + b;
+    return sum >= prime ? sum - prime : sum;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static inline TDigitType SubtructModulo( TDigitType a, TDigitType b, TDigitType prime )
+{
+    return a >= b ? a - b : a - b + prime;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Returns a * b mod prime. Used only for precalculations, hot loops use MontgomeryMultiply.
+static inline TDigitType MultiplyModulo( TDigitType a, TDigitType b, TDigitType prime )
+{
+    TDigitType high;
+    const TDigitType low = MultiplyDigits( a, b, high );
+    TDigitType remainder;
+    DivideDigits( high, low, prime, remainder );
+    return remainder;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static inline TDigitType PowerModulo( TDigitType base, TDigitType exponent, TDigitType prime )
+{
+    TDigitType result = 1;
+    for( ; exponent != 0; exponent >>= 1 )
+    {
+        if( exponent & 1 )
+            result = MultiplyModulo( result, base, prime );
+        base = MultiplyModulo( base, base, prime );
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Returns a * b * 2^-64 mod prime. Both a and b have to be less then prime.
+static inline TDigitType MontgomeryMultiply( TDigitType a, TDigitType b, const PrimeContext& context )
+{
+    // m is chosen so lower digits of a * b and m * prime are equal, hence ( a * b - m * prime ) / 2^64 is exact
+    // and it is equal to the difference of higher digits, that lies in range ( -prime, prime ).
+    TDigitType productHigh;
+    const TDigitType productLow = MultiplyDigits( a, b, productHigh );
+    const TDigitType m = productLow * context.m_primeInverse;
+    TDigitType reductionHigh;
+    MultiplyDigits( m, context.m_prime, reductionHigh );
+    return SubtructModulo( productHigh, reductionHigh, context.m_prime );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static inline TDigitType ToMontgomery( TDigitType value, const PrimeContext& context )
+{
+    return MontgomeryMultiply( value, context.m_montgomeryOneSquared, context );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static PrimeContext CreatePrimeContext( TDigitType prime, TDigitType primitiveRoot )
+{
+    PrimeContext context;
+    context.m_prime = prime;
+    context.m_primitiveRoot = primitiveRoot;
+
+    // Newton's iteration doubles number of correct bits. Prime is its own inverse modulo 2^3.
+    TDigitType inverse = prime;
+    for( uint32_t step = 0; step < 5; ++step )
+        inverse *= 2 - prime * inverse;
+
+    context.m_primeInverse = inverse;
+    context.m_montgomeryOne = ( 0 - prime ) % prime;
+    context.m_montgomeryOneSquared = MultiplyModulo( context.m_montgomeryOne, context.m_montgomeryOne, prime );
+    return context;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Fills roots table in Montgomery form. For each level with half length h, roots[ h + j ] = w^j, where w is root of unity of order 2h.
+static void BuildRoots( size_t transformSize, bool inverse, const PrimeContext& context, std::vector< TDigitType >& out_roots )
+{
+    out_roots.resize( transformSize );
+    for( size_t halfLength = 1; halfLength < transformSize; halfLength <<= 1 )
+    {
+        const TDigitType order = ( context.m_prime - 1 ) / ( 2 * halfLength );
+        const TDigitType exponent = inverse ? context.m_prime - 1 - order : order;
+        const TDigitType step = ToMontgomery( PowerModulo( context.m_primitiveRoot, exponent, context.m_prime ), context );
+
+        TDigitType root = context.m_montgomeryOne;
+        for( size_t idx = 0; idx < halfLength; ++idx )
+        {
+            out_roots[ halfLength + idx ] = root;
+            root = MontgomeryMultiply( root, step, context );
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Decimation in frequency transform. Takes coefficients in natural order and returns them in bit reversed order.
+static void ForwardTransform( TDigitType* data, size_t transformSize, const TDigitType* roots, const PrimeContext& context )
+{
+    const TDigitType prime = context.m_prime;
+    for( size_t halfLength = transformSize / 2; halfLength > 0; halfLength >>= 1 )
+    {
+        for( size_t start = 0; start < transformSize; start += 2 * halfLength )
+        {
+            TDigitType* low = data + start;
+            TDigitType* high = low + halfLength;
+            for( size_t idx = 0; idx < halfLength; ++idx )
+            {
+                const TDigitType u = low[ idx ];
+                const TDigitType v = high[ idx ];
+                low[ idx ] = AddModulo( u, v, prime );
+                high[ idx ] = MontgomeryMultiply( SubtructModulo( u, v, prime ), roots[ halfLength + idx ], context );
+            }
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Decimation in time transform with inverse roots. Takes coefficients in bit reversed order and returns them in natural order.
+// Result is not divided by the transform size.
+static void InverseTransform( TDigitType* data, size_t transformSize, const TDigitType* inverseRoots, const PrimeContext& context )
+{
+    const TDigitType prime = context.m_prime;
+    for( size_t halfLength = 1; halfLength < transformSize; halfLength <<= 1 )
+    {
+        for( size_t start = 0; start < transformSize; start += 2 * halfLength )
+        {
+            TDigitType* low = data + start;
+            TDigitType* high = low + halfLength;
+            for( size_t idx = 0; idx < halfLength; ++idx )
+            {
+                const TDigitType u = low[ idx ];
+                const TDigitType v = MontgomeryMultiply( high[ idx ], inverseRoots[ halfLength + idx ], context );
+                low[ idx ] = AddModulo( u, v, prime );
+                high[ idx ] = SubtructModulo( u, v, prime );
+            }
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static void LoadResidues( TConstRawBufferPtr number, uint32_t numberSize, size_t transformSize, TDigitType prime, std::vector< TDigitType >& out_residues )
+{
+    out_residues.assign( transformSize, 0 );
+    for( uint32_t idx = 0; idx < numberSize; ++idx )
+        out_residues[ idx ] = number[ idx ] % prime;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Calculates cyclic convolution of a and b modulo prime. Squares a if b is nullptr.
+static void Convolve( TConstRawBufferPtr a, uint32_t aSize, TConstRawBufferPtr b, uint32_t bSize, size_t transformSize,
+                      const PrimeContext& context, TransformBuffers& buffers, TDigitType* out_convolution )
+{
+    BuildRoots( transformSize, false, context, buffers.m_roots );
+    BuildRoots( transformSize, true, context, buffers.m_inverseRoots );
+
+    TDigitType* first = nullptr;
+    TDigitType* second = nullptr;
+    LoadResidues( a, aSize, transformSize, context.m_prime, buffers.m_first );
+    first = buffers.m_first.data();
+    ForwardTransform( first, transformSize, buffers.m_roots.data(), context );
+
+    if( b == nullptr )
+    {
+        second = first;
+    }
+    else
+    {
+        LoadResidues( b, bSize, transformSize, context.m_prime, buffers.m_second );
+        second = buffers.m_second.data();
+        ForwardTransform( second, transformSize, buffers.m_roots.data(), context );
+    }
+
+    // Montgomery multiplication of the transforms adds factor 2^-64. Scaling by 2^128/transformSize in Montgomery form
+    // removes it and also performs division by the transform size required by the inverse transform.
+    // transformSize divides prime - 1, so its inverse is equal to prime - ( prime - 1 ) / transformSize.
+    const TDigitType sizeInverse = context.m_prime - ( context.m_prime - 1 ) / transformSize;
+    const TDigitType scale = ToMontgomery( ToMontgomery( sizeInverse, context ), context );
+    for( size_t idx = 0; idx < transformSize; ++idx )
+        first[ idx ] = MontgomeryMultiply( MontgomeryMultiply( first[ idx ], second[ idx ], context ), scale, context );
+
+    InverseTransform( first, transformSize, buffers.m_inverseRoots.data(), context );
+    std::copy( first, first + transformSize, out_convolution );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static void MultiplyNtt( TConstRawBufferPtr a, uint32_t aSize, TConstRawBufferPtr b, uint32_t bSize, TRawBufferPtr out_result )
+{
+    const uint32_t resultSize = aSize + bSize;
+    const size_t convolutionSize = ( size_t )resultSize - 1;
+    size_t transformSize = 1;
+    while( transformSize < convolutionSize )
+        transformSize <<= 1;
+
+    PrimeContext contexts[ NUMBER_OF_PRIMES ];
+    for( uint32_t primeIdx = 0; primeIdx < NUMBER_OF_PRIMES; ++primeIdx )
+        contexts[ primeIdx ] = CreatePrimeContext( PRIMES[ primeIdx ], PRIMITIVE_ROOTS[ primeIdx ] );
+
+    TransformBuffers buffers;
+    std::vector< TDigitType > convolutions( NUMBER_OF_PRIMES * transformSize );
+    for( uint32_t primeIdx = 0; primeIdx < NUMBER_OF_PRIMES; ++primeIdx )
+        Convolve( a, aSize, b, bSize, transformSize, contexts[ primeIdx ], buffers, convolutions.data() + primeIdx * transformSize );
+
+    // Garner's algorithm. Coefficient x with residues r0, r1, r2 is restored as:
+    // x = r0 + p0 * t1 + p0 * p1 * t2
+    // t1 = ( r1 - r0 ) * p0^-1 mod p1
+    // t2 = ( ( r2 - r0 ) * p0^-1 - t1 ) * p1^-1 mod p2
+    const TDigitType p0 = PRIMES[ 0 ];
+    const TDigitType p1 = PRIMES[ 1 ];
+    const TDigitType p2 = PRIMES[ 2 ];
+    const TDigitType p0InverseModP1 = ToMontgomery( PowerModulo( p0, p1 - 2, p1 ), contexts[ 1 ] );
+    const TDigitType p0InverseModP2 = ToMontgomery( PowerModulo( p0, p2 - 2, p2 ), contexts[ 2 ] );
+    const TDigitType p1InverseModP2 = ToMontgomery( PowerModulo( p1, p2 - 2, p2 ), contexts[ 2 ] );
+    TDigitType p0p1High;
+    const TDigitType p0p1Low = MultiplyDigits( p0, p1, p0p1High );
+
+    const TDigitType* residues0 = convolutions.data();
+    const TDigitType* residues1 = residues0 + transformSize;
+    const TDigitType* residues2 = residues1 + transformSize;
+
+    // Coefficients overlap, so they are accumulated with carry. Accumulator has 3 limbs, since coefficients are less then 2^184.
+    TDigitType accumulator[ 3 ] = { 0, 0, 0 };
+    for( uint32_t idx = 0; idx < resultSize; ++idx )
+    {
+        TDigitType coefficient[ 3 ] = { 0, 0, 0 };
+        if( idx < convolutionSize )
+        {
+            const TDigitType r0 = residues0[ idx ];
+            const TDigitType t1 = MontgomeryMultiply( SubtructModulo( residues1[ idx ], r0, p1 ), p0InverseModP1, contexts[ 1 ] );
+            const TDigitType t2 = MontgomeryMultiply(
+                SubtructModulo( MontgomeryMultiply( SubtructModulo( residues2[ idx ], r0, p2 ), p0InverseModP2, contexts[ 2 ] ), t1, p2 ),
+                p1InverseModP2, contexts[ 2 ] );
+
+            // r0 + p0 * t1 is less then 2^124.
+            coefficient[ 0 ] = MultiplyDigits( p0, t1, coefficient[ 1 ] );
+            uint8_t carry = AddDigitsWithCarry( 0, coefficient[ 0 ], r0, coefficient[ 0 ] );
+            AddDigitsWithCarry( carry, coefficient[ 1 ], 0, coefficient[ 1 ] );
+
+            // p0 * p1 * t2
+            TDigitType lowProductHigh;
+            const TDigitType lowProductLow = MultiplyDigits( p0p1Low, t2, lowProductHigh );
+            TDigitType highProductHigh;
+            const TDigitType highProductLow = MultiplyDigits( p0p1High, t2, highProductHigh );
+            carry = AddDigitsWithCarry( 0, lowProductHigh, highProductLow, lowProductHigh );
+            AddDigitsWithCarry( carry, highProductHigh, 0, highProductHigh );
+
+            carry = AddDigitsWithCarry( 0, coefficient[ 0 ], lowProductLow, coefficient[ 0 ] );
+            carry = AddDigitsWithCarry( carry, coefficient[ 1 ], lowProductHigh, coefficient[ 1 ] );
+            AddDigitsWithCarry( carry, highProductHigh, 0, coefficient[ 2 ] );
+        }
+
+        uint8_t carry = AddDigitsWithCarry( 0, accumulator[ 0 ], coefficient[ 0 ], accumulator[ 0 ] );
+        carry = AddDigitsWithCarry( carry, accumulator[ 1 ], coefficient[ 1 ], accumulator[ 1 ] );
+        AddDigitsWithCarry( carry, accumulator[ 2 ], coefficient[ 2 ], accumulator[ 2 ] );
+
+        out_result[ idx ] = accumulator[ 0 ];
+        accumulator[ 0 ] = accumulator[ 1 ];
+        accumulator[ 1 ] = accumulator[ 2 ];
+        accumulator[ 2 ] = 0;
+    }
+}
+
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void NttMultiplier::Multiply( TConstRawBufferPtr a, uint32_t aSize, TConstRawBufferPtr b, uint32_t bSize, TRawBufferPtr out_result )
+{
+    helpers::MultiplyNtt( a, aSize, b, bSize, out_result );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void NttMultiplier::Square( TConstRawBufferPtr a, uint32_t aSize, TRawBufferPtr out_result )
+{
+    helpers::MultiplyNtt( a, aSize, nullptr, aSize, out_result );
+}
+
+}
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "../arithmeticImpl/typedefs.h"
+
+namespace sbn
+{
+namespace internal
+{
+
+// Class multiplies huge numbers using number theoretic transform ( NTT ).
+// Limbs are treated as coefficients of polynomials, which are convolved modulo three primes of form c*2^k+1.
+// Exact convolution is restored with chinese remainder theorem, so the cost is O(n*log(n)).
+class NttMultiplier
+{
+public:
+    // Multiplies a by b. Result has to have space for aSize + bSize limbs.
+    static void Multiply( TConstRawBufferPtr a, uint32_t aSize, TConstRawBufferPtr b, uint32_t bSize, TRawBufferPtr out_result );
+
+    // Squares a. Needs only two transforms per prime instead of three. Result has to have space for 2 * aSize limbs.
+    static void Square( TConstRawBufferPtr a, uint32_t aSize, TRawBufferPtr out_result );
+};
+
+}
+}
@@ -0,0 +1,228 @@
+#include "radixConverter.h"
+#include "../arithmeticImpl/typedefs.h"
+
+namespace sbn
+{
+namespace internal
+{
+
+namespace helpers
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Returns character of digit smaller then 32.
+static char DigitToChar( uint64_t digit )
+{
+    // [NOTE]: Select instead of lookup table, so loops over digits can be vectorized.
+    return ( char )( digit + ( digit < 10 ? '0' : 'a' - 10 ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Returns value of digit character or 0xFF, if character is neither decimal digit nor letter.
+static uint32_t CharToDigit( char character )
+{
+    // [NOTE]: Both values are computed and selected without branches, which would be mispredicted for random digits.
+    const uint32_t decimalValue = ( uint32_t )( uint8_t )character - '0';
+    const uint32_t letterValue = ( ( uint32_t )( uint8_t )character | 0x20 ) - 'a';
+    const uint32_t letterDigit = letterValue < 26 ? letterValue + 10 : 0xFF;
+    return decimalValue < 10 ? decimalValue : letterDigit;
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::string RadixConverter::ToString( const SimpleBigNum& number, uint32_t base )
+{
+    const uint32_t bitsPerDigit = GetBitsPerDigit( base );
+    if( bitsPerDigit == 0 )
+        return std::string();
+
+    if( number.IsZero() )
+        return "0";
+
+    const size_t numberOfDigits = ( ( size_t )number.GetNumberOfBits() + bitsPerDigit - 1 ) / bitsPerDigit;
+    std::string digits( numberOfDigits, '0' );
+    const uint64_t* limbs = number.m_numberLittleEndian.Data();
+    switch( bitsPerDigit )
+    {
+    case 1: WriteDigits_LimbAligned< 1 >( limbs, numberOfDigits, &digits[ 0 ] ); break;
+    case 2: WriteDigits_LimbAligned< 2 >( limbs, numberOfDigits, &digits[ 0 ] ); break;
+    case 4: WriteDigits_LimbAligned< 4 >( limbs, numberOfDigits, &digits[ 0 ] ); break;
+    default: WriteDigits_BitStream( limbs, number.GetNumberOfLimbs(), bitsPerDigit, numberOfDigits, &digits[ 0 ] ); break;
+    }
+
+    return digits;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool RadixConverter::FromString( const std::string& digits, uint32_t base, SimpleBigNum& out_number )
+{
+    const uint32_t bitsPerDigit = GetBitsPerDigit( base );
+    if( bitsPerDigit == 0 || digits.empty() )
+    {
+        out_number.SetZero();
+        return false;
+    }
+
+    const size_t numberOfLimbs = ( digits.size() * bitsPerDigit + DIGIT_BITS - 1 ) / DIGIT_BITS;
+    out_number.m_numberLittleEndian.Resize( ( uint32_t )numberOfLimbs );
+    out_number.m_numberLittleEndian.SetZero();
+    uint64_t* limbs = out_number.m_numberLittleEndian.Data();
+
+    bool isValid = false;
+    switch( bitsPerDigit )
+    {
+    case 1: isValid = ReadDigits_LimbAligned< 1 >( digits.data(), digits.size(), limbs ); break;
+    case 2: isValid = ReadDigits_LimbAligned< 2 >( digits.data(), digits.size(), limbs ); break;
+    case 4: isValid = ReadDigits_LimbAligned< 4 >( digits.data(), digits.size(), limbs ); break;
+    default: isValid = ReadDigits_BitStream( digits.data(), digits.size(), bitsPerDigit, limbs ); break;
+    }
+
+    if( !isValid )
+    {
+        out_number.SetZero();
+        return false;
+    }
+
+    out_number.RemoveLeadingZeros();
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t RadixConverter::GetBitsPerDigit( uint32_t base )
+{
+    switch( base )
+    {
+    case 2: return 1;
+    case 4: return 2;
+    case 8: return 3;
+    case 16: return 4;
+    case 32: return 5;
+    default: return 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template< uint32_t BITS_PER_DIGIT >
+void RadixConverter::WriteDigits_LimbAligned( const uint64_t* limbs, size_t numberOfDigits, char* out_digits )
+{
+    // [NOTE]: Number of digits in limb is known at compile time, so the inner loops can be unrolled and vectorized.
+    constexpr uint32_t digitsPerLimb = DIGIT_BITS / BITS_PER_DIGIT;
+    constexpr uint64_t digitMask = ( 1ull << BITS_PER_DIGIT ) - 1;
+    const size_t numberOfFullLimbs = numberOfDigits / digitsPerLimb;
+
+    // Digits of the limb are written backwards from the end of its part of the string.
+    char* limbDigitsEnd = out_digits + numberOfDigits;
+    for( size_t i = 0; i < numberOfFullLimbs; ++i )
+    {
+        const uint64_t limb = limbs[ i ];
+        limbDigitsEnd -= digitsPerLimb;
+        for( uint32_t j = 0; j < digitsPerLimb; ++j )
+            limbDigitsEnd[ digitsPerLimb - 1 - j ] = helpers::DigitToChar( ( limb >> ( j * BITS_PER_DIGIT ) ) & digitMask );
+    }
+
+    // Most significant limb can have less digits.
+    const uint32_t topDigits = ( uint32_t )( numberOfDigits % digitsPerLimb );
+    for( uint32_t j = 0; j < topDigits; ++j )
+        out_digits[ topDigits - 1 - j ] = helpers::DigitToChar( ( limbs[ numberOfFullLimbs ] >> ( j * BITS_PER_DIGIT ) ) & digitMask );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void RadixConverter::WriteDigits_BitStream( const uint64_t* limbs, uint32_t numberOfLimbs, uint32_t bitsPerDigit, size_t numberOfDigits, char* out_digits )
+{
+    const uint64_t digitMask = ( 1ull << bitsPerDigit ) - 1;
+
+    // Bits not written yet are kept in buffer, next limb is loaded, when the buffer has less bits then the digit.
+    uint64_t bitBuffer = limbs[ 0 ];
+    uint32_t bitsInBuffer = DIGIT_BITS;
+    uint32_t nextLimbIdx = 1;
+    for( size_t i = numberOfDigits; i > 0; --i )
+    {
+        uint64_t digit = bitBuffer;
+        if( bitsInBuffer >= bitsPerDigit )
+        {
+            bitBuffer >>= bitsPerDigit;
+            bitsInBuffer -= bitsPerDigit;
+        }
+        else
+        {
+            // Digit crosses limbs. Last digit can exceed the most significant limb, its missing bits are zeros.
+            const uint64_t nextLimb = nextLimbIdx < numberOfLimbs ? limbs[ nextLimbIdx ] : 0;
+            ++nextLimbIdx;
+            digit |= nextLimb << bitsInBuffer;
+            bitBuffer = nextLimb >> ( bitsPerDigit - bitsInBuffer );
+            bitsInBuffer += DIGIT_BITS - bitsPerDigit;
+        }
+
+        out_digits[ i - 1 ] = helpers::DigitToChar( digit & digitMask );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template< uint32_t BITS_PER_DIGIT >
+bool RadixConverter::ReadDigits_LimbAligned( const char* digits, size_t numberOfDigits, uint64_t* out_limbs )
+{
+    constexpr uint32_t digitsPerLimb = DIGIT_BITS / BITS_PER_DIGIT;
+    const size_t numberOfFullLimbs = numberOfDigits / digitsPerLimb;
+
+    // [NOTE]: Base is power of two, so all digits are valid, if their bitwise or is smaller then the base.
+    // Checking it once at the end keeps the loops free of branches.
+    uint32_t digitsOr = 0;
+    const char* limbDigitsEnd = digits + numberOfDigits;
+    for( size_t i = 0; i < numberOfFullLimbs; ++i )
+    {
+        limbDigitsEnd -= digitsPerLimb;
+        uint64_t limb = 0;
+        for( uint32_t j = 0; j < digitsPerLimb; ++j )
+        {
+            const uint32_t digit = helpers::CharToDigit( limbDigitsEnd[ digitsPerLimb - 1 - j ] );
+            digitsOr |= digit;
+            limb |= ( uint64_t )digit << ( j * BITS_PER_DIGIT );
+        }
+        out_limbs[ i ] = limb;
+    }
+
+    // Most significant limb can have less digits.
+    const uint32_t topDigits = ( uint32_t )( numberOfDigits % digitsPerLimb );
+    for( uint32_t j = 0; j < topDigits; ++j )
+    {
+        const uint32_t digit = helpers::CharToDigit( digits[ topDigits - 1 - j ] );
+        digitsOr |= digit;
+        out_limbs[ numberOfFullLimbs ] |= ( uint64_t )digit << ( j * BITS_PER_DIGIT );
+    }
+
+    return ( digitsOr >> BITS_PER_DIGIT ) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool RadixConverter::ReadDigits_BitStream( const char* digits, size_t numberOfDigits, uint32_t bitsPerDigit, uint64_t* out_limbs )
+{
+    uint32_t digitsOr = 0;
+
+    // Digits are collected in buffer, which is stored, when it is full. Bits of digit, which crosses limbs, start the next buffer.
+    uint64_t bitBuffer = 0;
+    uint32_t bitsInBuffer = 0;
+    size_t limbIdx = 0;
+    for( size_t i = numberOfDigits; i > 0; --i )
+    {
+        const uint32_t digit = helpers::CharToDigit( digits[ i - 1 ] );
+        digitsOr |= digit;
+
+        bitBuffer |= ( uint64_t )digit << bitsInBuffer;
+        bitsInBuffer += bitsPerDigit;
+        if( bitsInBuffer >= DIGIT_BITS )
+        {
+            out_limbs[ limbIdx++ ] = bitBuffer;
+            bitsInBuffer -= DIGIT_BITS;
+            bitBuffer = bitsInBuffer > 0 ? ( uint64_t )digit >> ( bitsPerDigit - bitsInBuffer ) : 0;
+        }
+    }
+
+    if( bitsInBuffer > 0 )
+        out_limbs[ limbIdx ] = bitBuffer;
+
+    return ( digitsOr >> bitsPerDigit ) == 0;
+}
+
+}
+}
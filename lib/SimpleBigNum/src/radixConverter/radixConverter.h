@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include "../../include/bigNum.h"
+
+namespace sbn
+{
+namespace internal
+{
+
+// Class converts numbers to and from strings in bases 2, 4, 8, 16 and 32. Every digit of such base is a group of bits of the
+// limbs, so digits are repacked from limbs without any arithmetic and the cost is O(n) both ways. Bases, which digits do not
+// cross limbs ( 2, 4, 16 ), are processed limb by limb with loops of fixed length, that compilers can vectorize. Bases 8 and
+// 32 are processed as a stream of bits.
+class RadixConverter
+{
+public:
+    // Returns representation of the number in given base without leading zeros. Digits above 9 are lowercase letters.
+    // Returns empty string, if base is not supported.
+    static std::string ToString( const SimpleBigNum& number, uint32_t base );
+
+    // Parses digits in given base to out_number. Both lowercase and uppercase letters are accepted. Returns false and sets
+    // out_number to zero, if base is not supported, the string is empty or contains characters, which are not digits of the base.
+    static bool FromString( const std::string& digits, uint32_t base, SimpleBigNum& out_number );
+
+private:
+    // Returns number of bits of single digit of given base or zero, if base is not supported.
+    static uint32_t GetBitsPerDigit( uint32_t base );
+
+    // Writes numberOfDigits digits of limbs, most significant first. Digits cannot cross limbs.
+    template< uint32_t BITS_PER_DIGIT >
+    static void WriteDigits_LimbAligned( const uint64_t* limbs, size_t numberOfDigits, char* out_digits );
+
+    // Writes numberOfDigits digits of limbs, most significant first.
+    static void WriteDigits_BitStream( const uint64_t* limbs, uint32_t numberOfLimbs, uint32_t bitsPerDigit, size_t numberOfDigits, char* out_digits );
+
+    // Packs numberOfDigits digits ( most significant first ) to zeroed limbs. Digits cannot cross limbs.
+    // Returns false, if any character is not a digit of the base.
+    template< uint32_t BITS_PER_DIGIT >
+    static bool ReadDigits_LimbAligned( const char* digits, size_t numberOfDigits, uint64_t* out_limbs );
+
+    // Packs numberOfDigits digits ( most significant first ) to zeroed limbs.
+    // Returns false, if any character is not a digit of the base.
+    static bool ReadDigits_BitStream( const char* digits, size_t numberOfDigits, uint32_t bitsPerDigit, uint64_t* out_limbs );
+};
+
+}
+}
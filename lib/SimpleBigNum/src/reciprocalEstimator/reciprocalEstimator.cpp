@@ -1,40 +1,122 @@
 #include "reciprocalEstimator.h"
+#include <algorithm>
 
 namespace sbn
 {
 namespace internal
 {
 
+namespace helpers
+{
+
+// Precision ( in base 256 digits ), up to which reciprocal is calculated by single limb division.
+constexpr static uint32_t BASECASE_PRECISION = 8;
+// Digits of precision added to every Newton's step to cover truncation errors.
+constexpr static uint32_t GUARD_DIGITS = 2;
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Returns the most significant precision digits of the number. Shorter number is extended with zeros at the bottom.
+static SimpleBigNum GetTopDigits( const SimpleBigNum& number, uint32_t precision )
+{
+    SimpleBigNum topDigits = number;
+    const uint32_t numberOfDigits = number.GetNumberOfDigits();
+    if( numberOfDigits > precision )
+        topDigits >> ( numberOfDigits - precision );
+    else
+        topDigits << ( precision - numberOfDigits );
+
+    return topDigits;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
-SimpleBigNum ReciprocalEstimator::Estimate( const SimpleBigNum& number, uint32_t shift, uint32_t maxSteps )
+// Returns 256^( 2 * precision ) / top, where top are the most significant precision digits of the number.
+// Result is off by a few units at most.
+static SimpleBigNum EstimateTopReciprocal( const SimpleBigNum& number, uint32_t precision )
 {
-    // Estimates reciprocal using Netwon's method:
-    // Function used:
-    // f(x) = 1/x - ( number >> shift );
-    // f'(x) =  - 1/x^2
-    //
-    // Final Newton's method step:
-    // x1 = 2 * x0 - ( number >> shift ) * x0^2
-
-    SimpleBigNum estimatedValue( 1 );
-    estimatedValue << ( shift - number.GetNumberOfDigits() );
-
-    for( uint32_t step = 0; step < maxSteps; ++step )
+    const SimpleBigNum topDigits = GetTopDigits( number, precision );
+    if( precision <= BASECASE_PRECISION )
+    {
+        SimpleBigNum reciprocal( 1 );
+        reciprocal << ( 2 * precision );
+        reciprocal /= topDigits;
+        return reciprocal;
+    }
+
+    // Newton's step for f(x) = 1/x - top, started from reciprocal of about half of the precision:
+    // x0 = z * 256^(p-h), where z ~ 256^(2h) / top_h
+    // x1 = x0 + x0 * ( 1 - top * x0 / 256^(2p) ) = x0 + z * ( 256^(p+h) - top * z ) / 256^(2h)
+    // Relative error of x1 is the square of the error of x0, so precision doubles with every step
+    // and all steps together cost about as much as two multiplications of the full precision.
+    const uint32_t halfPrecision = ( precision + 1 ) / 2 + GUARD_DIGITS;
+    const SimpleBigNum halfReciprocal = EstimateTopReciprocal( number, halfPrecision );
+
+    SimpleBigNum residual = topDigits;
+    residual *= halfReciprocal;             // top * z
+    SimpleBigNum power( 1 );
+    power << ( precision + halfPrecision ); // 256^(p+h)
+
+    // Residual is about 256^(p+h) times error of z, so only its top digits affect units of the result.
+    const uint32_t truncatedDigits = halfPrecision - GUARD_DIGITS;
+    const bool isEstimateTooBig = residual > power;
+    if( isEstimateTooBig )
+    {
+        residual -= power;
+    }
+    else
     {
-        SimpleBigNum subtrahend = estimatedValue;
-        subtrahend *= subtrahend;       // x0^2
-        subtrahend *= number;           // x0^2 * number
-        subtrahend >> shift;            // ( number >> shift ) * x0^2
+        power -= residual;
+        std::swap( residual, power );
+    }
+
+    residual >> truncatedDigits;
+    residual *= halfReciprocal;
+    residual >> ( 2 * halfPrecision - truncatedDigits );
+
+    SimpleBigNum reciprocal = halfReciprocal;
+    reciprocal << ( precision - halfPrecision );
+    if( isEstimateTooBig )
+        reciprocal -= residual;
+    else
+        reciprocal += residual;
+
+    return reciprocal;
+}
 
-        if( estimatedValue == subtrahend ) // The result won't be impromved.
-            break;
+}
 
-        estimatedValue *= 2;            // 2 * x0
-        estimatedValue -= subtrahend;   // 2 * x0 - ( number >> shift ) * x0^2
+///////////////////////////////////////////////////////////////////////////////////////////
+SimpleBigNum ReciprocalEstimator::Estimate( const SimpleBigNum& number, uint32_t shift )
+{
+    // Reciprocal is estimated with precision p not less then number of digits m, so that whole number is used:
+    // 256^(2p) / ( number * 256^(p-m) ) = 256^(p+m) / number
+    // Newton's estimate is corrected to the exact value using the remainder and shifted right to the wanted precision.
+    const uint32_t numberOfDigits = number.GetNumberOfDigits();
+    if( shift + 1 < numberOfDigits )
+        return SimpleBigNum();
+
+    const uint32_t precision = std::max( numberOfDigits, shift > numberOfDigits ? shift - numberOfDigits : 0 );
+    SimpleBigNum reciprocal = helpers::EstimateTopReciprocal( number, precision );
+
+    SimpleBigNum power( 1 );
+    power << ( precision + numberOfDigits );
+    SimpleBigNum product = reciprocal;
+    product *= number;
+    while( product > power )
+    {
+        reciprocal -= 1;
+        product -= number;
     }
 
-    return estimatedValue;
+    power -= product;
+    while( power >= number )
+    {
+        reciprocal += 1;
+        power -= number;
+    }
+
+    reciprocal >> ( precision + numberOfDigits - shift );
+    return reciprocal;
 }
 
 }
-}
\ No newline at end of file
+}
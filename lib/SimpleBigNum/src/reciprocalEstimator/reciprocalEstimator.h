@@ -10,8 +10,9 @@ namespace internal
 class ReciprocalEstimator
 {
 public:
-    static SimpleBigNum Estimate( const SimpleBigNum& number, uint32_t shift, uint32_t maxSteps );
+    // Returns floor( 256^shift / number ). Number cannot be zero.
+    static SimpleBigNum Estimate( const SimpleBigNum& number, uint32_t shift );
 };
 
 }
-}
\ No newline at end of file
+}
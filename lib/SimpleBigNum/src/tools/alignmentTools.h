@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 
@@ -7,6 +8,9 @@ namespace sbn
 namespace tools
 {
 
+// Alignment of buffers used by simd kernels. Big enough for AVX-512 vectors.
+constexpr size_t SIMD_ALIGNMENT = 64;
+
 // Returns true if given numeric value is power of 2.
 template< typename T > constexpr bool isPowerOfTwo( T value );
 
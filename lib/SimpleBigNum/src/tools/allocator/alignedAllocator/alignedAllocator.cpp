@@ -7,8 +7,6 @@ namespace sbn
 namespace tools
 {
 
-static const size_t SIMD_ALIGNMENT = 16;
-
 /////////////////////////////////////////////////////////////////////////////////////////
 void* AlignedAllocator::Allocate( size_t requestedSize )
 {
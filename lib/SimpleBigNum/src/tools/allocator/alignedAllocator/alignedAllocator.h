@@ -6,7 +6,7 @@ namespace sbn
 namespace tools
 {
 
-// Alloctor which allocates memory aligned to 16 byte boundary.
+// Alloctor which allocates memory aligned to SIMD_ALIGNMENT byte boundary.
 class AlignedAllocator : public IAllocator
 {
 public:
@@ -0,0 +1,110 @@
+#include "cpuInfo.h"
+#include <cstdint>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#include <immintrin.h>
+#elif defined( __x86_64__ ) || defined( __i386__ )
+#include <cpuid.h>
+#endif
+
+namespace sbn
+{
+namespace tools
+{
+namespace helpers
+{
+
+// Registers returned by cpuid instruction.
+struct CpuIdRegs
+{
+    uint32_t m_eax = 0;
+    uint32_t m_ebx = 0;
+    uint32_t m_ecx = 0;
+    uint32_t m_edx = 0;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////
+static CpuIdRegs CpuId( uint32_t leaf, uint32_t subLeaf )
+{
+    CpuIdRegs regs;
+#if defined( _MSC_VER )
+    int info[ 4 ];
+    __cpuidex( info, ( int )leaf, ( int )subLeaf );
+    regs.m_eax = ( uint32_t )info[ 0 ];
+    regs.m_ebx = ( uint32_t )info[ 1 ];
+    regs.m_ecx = ( uint32_t )info[ 2 ];
+    regs.m_edx = ( uint32_t )info[ 3 ];
+#elif defined( __x86_64__ ) || defined( __i386__ )
+    if( leaf <= ( uint32_t )__get_cpuid_max( 0, nullptr ) )
+        __cpuid_count( leaf, subLeaf, regs.m_eax, regs.m_ebx, regs.m_ecx, regs.m_edx );
+#endif
+    return regs;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+static uint64_t GetEnabledXStateFeatures()
+{
+    // Returns XCR0 register, which tells which register states are saved by the os.
+#if defined( _MSC_VER )
+    return _xgetbv( 0 );
+#elif defined( __x86_64__ ) || defined( __i386__ )
+    uint32_t eax, edx;
+    __asm__ volatile( "xgetbv" : "=a"( eax ), "=d"( edx ) : "c"( 0 ) );
+    return ( ( uint64_t )edx << 32 ) | eax;
+#else
+    return 0;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+static bool IsBitSet( uint32_t reg, uint32_t bit )
+{
+    return ( reg & ( 1u << bit ) ) != 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+static CpuFeatures DetectCpuFeatures()
+{
+    CpuFeatures features;
+
+    const uint32_t maxLeaf = CpuId( 0, 0 ).m_eax;
+    if( maxLeaf < 1 )
+        return features;
+
+    const CpuIdRegs leaf1 = CpuId( 1, 0 );
+    features.m_sse41 = IsBitSet( leaf1.m_ecx, 9 ) && IsBitSet( leaf1.m_ecx, 19 );
+
+    const bool osxsave = IsBitSet( leaf1.m_ecx, 27 );
+    if( maxLeaf < 7 || !osxsave )
+        return features;
+
+    const uint64_t xcr0 = GetEnabledXStateFeatures();
+    const bool ymmEnabled = ( xcr0 & 0x6 ) == 0x6;
+    const bool zmmEnabled = ( xcr0 & 0xE6 ) == 0xE6;
+
+    const CpuIdRegs leaf7 = CpuId( 7, 0 );
+    features.m_bmi2 = IsBitSet( leaf7.m_ebx, 8 );
+    features.m_adx = IsBitSet( leaf7.m_ebx, 19 );
+    features.m_avx2 = ymmEnabled && IsBitSet( leaf1.m_ecx, 28 ) && IsBitSet( leaf7.m_ebx, 5 );
+    features.m_avx512 = zmmEnabled && features.m_avx2
+        && IsBitSet( leaf7.m_ebx, 16 )  // F
+        && IsBitSet( leaf7.m_ebx, 17 )  // DQ
+        && IsBitSet( leaf7.m_ebx, 30 )  // BW
+        && IsBitSet( leaf7.m_ebx, 31 ); // VL
+    features.m_avx512ifma = features.m_avx512 && IsBitSet( leaf7.m_ebx, 21 );
+
+    return features;
+}
+
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+const CpuFeatures& GetCpuFeatures()
+{
+    static const CpuFeatures features = helpers::DetectCpuFeatures();
+    return features;
+}
+
+}
+}
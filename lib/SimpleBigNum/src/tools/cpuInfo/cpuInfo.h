@@ -0,0 +1,23 @@
+#pragma once
+
+namespace sbn
+{
+namespace tools
+{
+
+// Describes features of the cpu, that are used by simd kernels.
+struct CpuFeatures
+{
+    bool m_sse41 = false;       // SSSE3 and SSE4.1.
+    bool m_avx2 = false;        // AVX2 with os support for ymm registers.
+    bool m_avx512 = false;      // AVX-512 F, BW, DQ and VL with os support for zmm registers.
+    bool m_avx512ifma = false;  // AVX-512 IFMA52.
+    bool m_bmi2 = false;
+    bool m_adx = false;
+};
+
+// Returns features of the cpu, on which code is running. Detection is done only once.
+const CpuFeatures& GetCpuFeatures();
+
+}
+}
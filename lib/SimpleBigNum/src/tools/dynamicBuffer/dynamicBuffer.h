@@ -1,6 +1,8 @@
 #pragma once
+#include <algorithm>
 #include <cstring>
 #include "../allocator/iAllocator.h"
+#include "../alignmentTools.h"
 
 namespace sbn
 {
@@ -8,6 +10,8 @@ namespace tools
 {
 
 // Implements linear buffer with dynamic size.
+// [NOTE]: Capacity of the buffer is always rounded up to the multiple of SIMD_ALIGNMENT bytes and all elements
+// between Size() and Capacity() are kept zeroed, so simd kernels can safely read and write whole vectors past the end.
 template< typename T >
 class DynamicBuffer
 {
@@ -24,9 +28,12 @@ public:
     // Dtor. Releases all used resources.
     ~DynamicBuffer();
 
-    // Resizes buffer to have given new size. 
+    // Resizes buffer to have given new size. New elements are zeroed.
     void Resize( size_t newSize );
 
+    // Sets all elements to zero.
+    void SetZero();
+
     // Grows the buffer if needed and places newElement at the end of the buffer.
     void PushBack( const T& newElement );
 
@@ -53,7 +60,7 @@ public:
     const T* Data() const;
 
     // Returns true if data of other is equal to data of this buffer.
-    bool IsEqualTo( const DynamicBuffer< T >& other );
+    bool IsEqualTo( const DynamicBuffer< T >& other ) const;
 
     // Operators:
     DynamicBuffer& operator=( const DynamicBuffer& other );
@@ -61,9 +68,13 @@ public:
     // -------
 
 private:
-    const size_t MIN_CAPACITY = 16;
+    static_assert( SIMD_ALIGNMENT % sizeof( T ) == 0, "Size of element has to divide simd alignment." );
+    static constexpr size_t MIN_CAPACITY = SIMD_ALIGNMENT / sizeof( T );
+
+    // Returns capacity, that is able to hold given number of elements and is rounded up to simd alignment.
+    static size_t CalcCapacity( size_t numberOfElements );
 
-    IAllocator& m_allocator;
+    IAllocator* m_allocator;
     T* m_buffer;
     size_t m_currentSize;
     size_t m_currentCapacity;
@@ -78,11 +89,12 @@ private:
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename T>
 inline DynamicBuffer<T>::DynamicBuffer( IAllocator& allocator )
-    : m_allocator( allocator )
+    : m_allocator( &allocator )
     , m_currentSize( 0 )
     , m_currentCapacity( MIN_CAPACITY )
 {
     m_buffer = static_cast< T* >( allocator.Allocate( m_currentCapacity * sizeof( T ) ) );
+    memset( m_buffer, 0, m_currentCapacity * sizeof( T ) );
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -94,6 +106,7 @@ inline DynamicBuffer<T>::DynamicBuffer( DynamicBuffer&& other )
 {
     m_buffer = other.m_buffer;
     other.m_currentSize = 0;
+    other.m_currentCapacity = 0;
     other.m_buffer = nullptr;
 }
 
@@ -102,17 +115,18 @@ template<typename T>
 inline DynamicBuffer<T>::DynamicBuffer( const DynamicBuffer& other )
     : m_allocator( other.m_allocator )
     , m_currentSize( other.m_currentSize )
-    , m_currentCapacity( other.m_currentCapacity )
+    , m_currentCapacity( CalcCapacity( other.m_currentSize ) )
 {
-    m_buffer = m_allocator.Allocate( m_currentCapacity );
-    memcpy( m_buffer, other.m_buffer, m_currentCapacity * sizeof( T ) );
+    m_buffer = static_cast< T* >( m_allocator->Allocate( m_currentCapacity * sizeof( T ) ) );
+    memcpy( m_buffer, other.m_buffer, m_currentSize * sizeof( T ) );
+    memset( m_buffer + m_currentSize, 0, ( m_currentCapacity - m_currentSize ) * sizeof( T ) );
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename T>
 inline DynamicBuffer<T>::~DynamicBuffer()
 {
-    m_allocator.Free( m_buffer );
+    m_allocator->Free( m_buffer );
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -124,24 +138,40 @@ inline void DynamicBuffer<T>::Resize( size_t newSize )
     if( newSize > m_currentCapacity || newSize <= m_currentCapacity / 4 )
     {
         // If current buffer is to small, allocate a new one, with 2x bigger capacity.
-        wantedCapacity = std::max< size_t >( MIN_CAPACITY, newSize * 2 );
+        wantedCapacity = CalcCapacity( newSize * 2 );
     }
 
     if( wantedCapacity != m_currentCapacity )
     {
         // Reallocate the buffer.
-        T* newMem = static_cast< T* >( m_allocator.Allocate( wantedCapacity * sizeof( T ) ) );
-        auto copySize = wantedCapacity > m_currentCapacity ? m_currentSize : newSize;
-        memcpy( newMem, m_buffer, copySize * sizeof( T ) );
-        m_allocator.Free( m_buffer );
+        T* newMem = static_cast< T* >( m_allocator->Allocate( wantedCapacity * sizeof( T ) ) );
+        auto copySize = std::min( m_currentSize, newSize );
+        if( copySize > 0 )
+            memcpy( newMem, m_buffer, copySize * sizeof( T ) );
+        m_allocator->Free( m_buffer );
         m_buffer = newMem;
         m_currentCapacity = wantedCapacity;
         memset( newMem + copySize, 0, ( m_currentCapacity - copySize ) * sizeof( T ) );
     }
+    else if( newSize < m_currentSize )
+    {
+        // Keep elements past the end zeroed.
+        // [NOTE]: Size never exceeds capacity. Clamping it shows the compiler, that the count cannot wrap around ( for example,
+        // when PushBack passes m_currentSize + 1 ), otherwise gcc warns about memset bound exceeding maximum object size.
+        const size_t removedElements = std::min( m_currentSize, m_currentCapacity ) - newSize;
+        memset( m_buffer + newSize, 0, removedElements * sizeof( T ) );
+    }
 
     m_currentSize = newSize;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+inline void DynamicBuffer<T>::SetZero()
+{
+    memset( m_buffer, 0, m_currentSize * sizeof( T ) );
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename T>
 inline void DynamicBuffer<T>::PushBack( const T& newElement )
@@ -222,7 +252,7 @@ inline const T* DynamicBuffer<T>::Data() const
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename T>
-inline bool DynamicBuffer<T>::IsEqualTo( const DynamicBuffer<T>& other )
+inline bool DynamicBuffer<T>::IsEqualTo( const DynamicBuffer<T>& other ) const
 {
     if( Size() == other.Size() )
         return memcmp( m_buffer, other.m_buffer, m_currentSize * sizeof( T ) ) == 0;
@@ -234,7 +264,12 @@ inline bool DynamicBuffer<T>::IsEqualTo( const DynamicBuffer<T>& other )
 template<typename T>
 inline DynamicBuffer<T>& DynamicBuffer<T>::operator=( const DynamicBuffer& other )
 {
-    *this = DynamicBuffer( other );
+    if( this != &other )
+    {
+        // Reuse current memory when possible.
+        Resize( other.m_currentSize );
+        memcpy( m_buffer, other.m_buffer, m_currentSize * sizeof( T ) );
+    }
     return *this;
 }
 
@@ -242,14 +277,21 @@ inline DynamicBuffer<T>& DynamicBuffer<T>::operator=( const DynamicBuffer& other
 template<typename T>
 inline DynamicBuffer<T>& DynamicBuffer<T>::operator=( DynamicBuffer&& other )
 {
-    m_allocator = other.m_allocator;
-    m_currentSize = other.m_currentSize;
-    m_currentCapacity = other.m_currentCapacity;
-    m_buffer = other.m_buffer;
-    other.m_currentSize = 0;
-    other.m_buffer = nullptr;
+    // Swap the content, so the old buffer is released by other.
+    std::swap( m_allocator, other.m_allocator );
+    std::swap( m_currentSize, other.m_currentSize );
+    std::swap( m_currentCapacity, other.m_currentCapacity );
+    std::swap( m_buffer, other.m_buffer );
     return *this;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+inline size_t DynamicBuffer<T>::CalcCapacity( size_t numberOfElements )
+{
+    const size_t capacityInBytes = align< size_t, SIMD_ALIGNMENT >( std::max( MIN_CAPACITY, numberOfElements ) * sizeof( T ) );
+    return capacityInBytes / sizeof( T );
+}
+
 }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <random>
 #include <limits>
+#include "../../../lib/SimpleBigNum/include/bigNum.h"
 
 template< typename T>
 class BaseTestWithRandomGenerator : public ::testing::Test
@@ -18,6 +19,17 @@ private:
     std::uniform_int_distribution<T> m_random;
 };
 
+class BaseTestWithRandomBigNums : public BaseTestWithRandomGenerator< uint64_t >
+{
+public:
+    // Ctor
+    BaseTestWithRandomBigNums();
+
+    // Returns random number with exactly numberOfDigits digits ( base 256 ). A quarter of digits is 255,
+    // so carries and borrows are propagated over long distances.
+    sbn::SimpleBigNum GetNextRandomBigNum( uint32_t numberOfDigits );
+};
+
 ///////////////////////////////////////////////////////////////////////////
 //
 // IMPLEMENTATION:
@@ -38,3 +50,19 @@ inline T BaseTestWithRandomGenerator<T>::GetNextRandomNumber()
 {
     return m_random( m_engine );
 }
+
+///////////////////////////////////////////////////////////////////////////
+inline BaseTestWithRandomBigNums::BaseTestWithRandomBigNums()
+    : BaseTestWithRandomGenerator( 0, 0xFFFFFFFFFFFFFFFF )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////
+inline sbn::SimpleBigNum BaseTestWithRandomBigNums::GetNextRandomBigNum( uint32_t numberOfDigits )
+{
+    sbn::SimpleBigNum::TRawNumberDigits digits( numberOfDigits );
+    for( auto& digit : digits )
+        digit = ( GetNextRandomNumber() % 4 == 0 ) ? 0xFF : ( uint8_t )GetNextRandomNumber();
+    digits.back() |= 1;
+    return sbn::SimpleBigNum( digits.begin(), digits.end() );
+}
@@ -6,6 +6,15 @@ class AdditionUnittests : public BaseTestWithRandomGenerator< uint64_t >
 {
 public:
     AdditionUnittests() : BaseTestWithRandomGenerator( 0, 0x7FFFFFFFFFFFFFFF ) {}
+
+    // Returns random digits, half of which are equal to 255, so carries are propagated over long distances.
+    SimpleBigNum::TRawNumberDigits GetNextRandomDigits( uint32_t size )
+    {
+        SimpleBigNum::TRawNumberDigits digits( size );
+        for( auto& digit : digits )
+            digit = GetNextRandomNumber() % 2 == 0 ? 255 : ( uint8_t )GetNextRandomNumber();
+        return digits;
+    }
 };
 
 TEST_F( AdditionUnittests, simple_addition_with_carry )
@@ -19,6 +28,18 @@ TEST_F( AdditionUnittests, simple_addition_with_carry )
     ASSERT_EQ( bigNumber.ToString(), std::to_string( 16777216 ) );
 }
 
+TEST_F( AdditionUnittests, addition_with_carry_across_limbs )
+{
+    SimpleBigNum::TRawNumberDigits digits = { 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 };
+
+    SimpleBigNum bigNumber( digits.begin(), digits.end() );
+
+    bigNumber += 1;
+
+    ASSERT_EQ( bigNumber.ToString(), "1208925819614629174706176" );
+    ASSERT_EQ( bigNumber.GetNumberOfDigits(), 11 );
+}
+
 TEST_F( AdditionUnittests, simple_addition_with_zero )
 {
     const uint64_t num = GetNextRandomNumber();
@@ -77,4 +98,20 @@ TEST_F( AdditionUnittests, arithmetic_progression_sum )
     }
         
     ASSERT_EQ( sum.ToString(), "4590690190930935000000" );
-}
\ No newline at end of file
+}
+
+TEST_F( AdditionUnittests, scalar_addition_should_match_big_number_addition )
+{
+    for( uint32_t i = 0; i < 1000; ++i )
+    {
+        const SimpleBigNum::TRawNumberDigits digits = GetNextRandomDigits( GetNextRandomNumber() % 40 + 1 );
+
+        const uint64_t value = GetNextRandomNumber() * 2 + 1;
+        SimpleBigNum wanted( digits.begin(), digits.end() );
+        wanted += SimpleBigNum( value );
+
+        SimpleBigNum bigNumber( digits.begin(), digits.end() );
+        bigNumber += value;
+        ASSERT_EQ( bigNumber, wanted );
+    }
+}
@@ -0,0 +1,198 @@
+#include "pch.h"
+#include "../../lib/SimpleBigNum/src/arithmeticImpl/arithmeticImpl.h"
+
+using namespace sbn;
+using namespace sbn::internal;
+
+class ArithmeticImplUnittests : public BaseTestWithRandomGenerator< uint64_t >
+{
+public:
+    ArithmeticImplUnittests() : BaseTestWithRandomGenerator( 0, 0xFFFFFFFFFFFFFFFF ) {}
+
+    void SetUp() override { m_originalType = GetImplType(); }
+    void TearDown() override { ForceImplType( m_originalType ); }
+
+    // Returns random number, whose digits are often 0 or 255, so carries and borrows are propagated over long distances.
+    SimpleBigNum GetNextRandomBigNumber( uint32_t digits )
+    {
+        SimpleBigNum::TRawNumberDigits rawDigits( digits );
+        for( auto& digit : rawDigits )
+        {
+            const uint64_t random = GetNextRandomNumber();
+            digit = ( random % 4 == 0 ) ? 0 : ( random % 4 == 1 ? ( uint8_t )random : 255 );
+        }
+
+        return SimpleBigNum( rawDigits.begin(), rawDigits.end() );
+    }
+
+private:
+    ImplType m_originalType;
+};
+
+TEST_F( ArithmeticImplUnittests, all_supported_impl_types_should_give_same_results )
+{
+    const ImplType types[] = { ImplType::Generic, ImplType::Sse, ImplType::Avx2, ImplType::Avx512 };
+
+    for( uint32_t i = 0; i < 1000; ++i )
+    {
+        const SimpleBigNum a = GetNextRandomBigNumber( ( uint32_t )( GetNextRandomNumber() % 700 ) + 1 );
+        const SimpleBigNum b = GetNextRandomBigNumber( ( uint32_t )( GetNextRandomNumber() % 700 ) + 1 );
+        const SimpleBigNum& bigger = std::max( a, b );
+        const SimpleBigNum& smaller = std::min( a, b );
+
+        ASSERT_TRUE( ForceImplType( ImplType::Generic ) );
+        SimpleBigNum wantedSum = a;
+        wantedSum += b;
+        SimpleBigNum wantedDifference = bigger;
+        wantedDifference -= smaller;
+        SimpleBigNum wantedProduct = a;
+        wantedProduct *= b;
+
+        for( const ImplType type : types )
+        {
+            if( !ForceImplType( type ) )
+                continue;
+
+            SimpleBigNum sum = a;
+            sum += b;
+            ASSERT_EQ( sum, wantedSum );
+
+            SimpleBigNum difference = bigger;
+            difference -= smaller;
+            ASSERT_EQ( difference, wantedDifference );
+
+            SimpleBigNum product = a;
+            product *= b;
+            ASSERT_EQ( product, wantedProduct );
+        }
+    }
+}
+
+TEST_F( ArithmeticImplUnittests, multiplication_kernels_should_handle_any_operand_sizes )
+{
+    // Bignum multiplication calls kernels only for small operands, so blocking of long operands is tested directly.
+    const ImplType types[] = { ImplType::Sse, ImplType::Avx2, ImplType::Avx512 };
+
+    for( uint32_t i = 0; i < 200; ++i )
+    {
+        const uint32_t aSize = ( uint32_t )( GetNextRandomNumber() % 600 ) + 1;
+        const uint32_t bSize = ( i % 2 == 0 ) ? ( uint32_t )( GetNextRandomNumber() % 600 ) + 1 : ( uint32_t )( GetNextRandomNumber() % 4 ) + 1;
+        std::vector< uint64_t > a( aSize );
+        std::vector< uint64_t > b( bSize );
+        for( auto& digit : a )
+            digit = GetNextRandomNumber() % 3 == 0 ? 0xFFFFFFFFFFFFFFFF : GetNextRandomNumber();
+        for( auto& digit : b )
+            digit = GetNextRandomNumber() % 3 == 0 ? 0xFFFFFFFFFFFFFFFF : GetNextRandomNumber();
+
+        ASSERT_TRUE( ForceImplType( ImplType::Generic ) );
+        std::vector< uint64_t > wantedProduct( aSize + bSize, 0 );
+        MultiplyInplaceImpl( a.data(), aSize, b.data(), bSize, wantedProduct.data() );
+
+        for( const ImplType type : types )
+        {
+            if( !ForceImplType( type ) )
+                continue;
+
+            std::vector< uint64_t > product( aSize + bSize, 0 );
+            MultiplyInplaceImpl( a.data(), aSize, b.data(), bSize, product.data() );
+            ASSERT_EQ( product, wantedProduct );
+        }
+    }
+}
+
+TEST_F( ArithmeticImplUnittests, square_kernels_should_match_multiplication )
+{
+    const ImplType types[] = { ImplType::Generic, ImplType::Sse, ImplType::Avx2, ImplType::Avx512 };
+
+    for( uint32_t i = 0; i < 200; ++i )
+    {
+        const uint32_t size = ( uint32_t )( GetNextRandomNumber() % 300 ) + 1;
+        std::vector< uint64_t > number( size );
+        for( auto& digit : number )
+            digit = GetNextRandomNumber() % 3 == 0 ? 0xFFFFFFFFFFFFFFFF : GetNextRandomNumber();
+
+        ASSERT_TRUE( ForceImplType( ImplType::Generic ) );
+        std::vector< uint64_t > wantedSquare( 2 * size, 0 );
+        MultiplyInplaceImpl( number.data(), size, number.data(), size, wantedSquare.data() );
+
+        for( const ImplType type : types )
+        {
+            if( !ForceImplType( type ) )
+                continue;
+
+            std::vector< uint64_t > square( 2 * size, 0 );
+            SquareInplaceImpl( number.data(), size, square.data() );
+            ASSERT_EQ( square, wantedSquare );
+        }
+    }
+}
+
+TEST_F( ArithmeticImplUnittests, decimal_kernels_should_match_generic_ones )
+{
+    const ImplType types[] = { ImplType::Sse, ImplType::Avx2, ImplType::Avx512 };
+
+    for( uint32_t i = 0; i < 200; ++i )
+    {
+        // Chunks with many nines and zeros hit borders of the digit groups.
+        const uint32_t numberOfChunks = ( uint32_t )( GetNextRandomNumber() % 20 );
+        std::vector< uint64_t > chunks( numberOfChunks );
+        for( auto& chunk : chunks )
+        {
+            const uint64_t random = GetNextRandomNumber();
+            chunk = random % 4 == 0 ? DECIMAL_CHUNK_BASE - 1 - random % 1000 : ( random % 4 == 1 ? random % 100000000 : random % DECIMAL_CHUNK_BASE );
+        }
+
+        ASSERT_TRUE( ForceImplType( ImplType::Generic ) );
+        std::string wantedDigits( numberOfChunks * DECIMAL_CHUNK_DIGITS, ' ' );
+        WriteDecimalChunksImpl( chunks.data(), numberOfChunks, &wantedDigits[ 0 ] );
+
+        for( const ImplType type : types )
+        {
+            if( !ForceImplType( type ) )
+                continue;
+
+            std::string digits( numberOfChunks * DECIMAL_CHUNK_DIGITS, ' ' );
+            WriteDecimalChunksImpl( chunks.data(), numberOfChunks, &digits[ 0 ] );
+            ASSERT_EQ( digits, wantedDigits );
+
+            std::vector< uint64_t > parsedChunks( numberOfChunks );
+            ReadDecimalChunksImpl( digits.data(), numberOfChunks, parsedChunks.data() );
+            ASSERT_EQ( parsedChunks, chunks );
+            ASSERT_TRUE( IsDecimalStringImpl( digits.data(), digits.size() ) );
+        }
+    }
+}
+
+TEST_F( ArithmeticImplUnittests, decimal_validation_should_find_every_invalid_character )
+{
+    const ImplType types[] = { ImplType::Generic, ImplType::Sse, ImplType::Avx2, ImplType::Avx512 };
+    const char invalidCharacters[] = { '/', ':', ' ', 'a', '\0', ( char )0x80, ( char )0xB0, ( char )0xFF };
+
+    for( const ImplType type : types )
+    {
+        if( !ForceImplType( type ) )
+            continue;
+
+        for( uint32_t size = 0; size < 100; ++size )
+        {
+            std::string digits( size, '0' );
+            for( auto& digit : digits )
+                digit = ( char )( '0' + GetNextRandomNumber() % 10 );
+            ASSERT_TRUE( IsDecimalStringImpl( digits.data(), size ) );
+
+            for( uint32_t charIdx = 0; charIdx < size; ++charIdx )
+            {
+                std::string invalidDigits = digits;
+                invalidDigits[ charIdx ] = invalidCharacters[ GetNextRandomNumber() % sizeof( invalidCharacters ) ];
+                ASSERT_FALSE( IsDecimalStringImpl( invalidDigits.data(), size ) );
+            }
+        }
+    }
+}
+
+TEST_F( ArithmeticImplUnittests, forcing_generic_impl_should_always_succeed )
+{
+    ASSERT_TRUE( IsImplTypeSupported( ImplType::Generic ) );
+    ASSERT_TRUE( ForceImplType( ImplType::Generic ) );
+    ASSERT_EQ( GetImplType(), ImplType::Generic );
+}
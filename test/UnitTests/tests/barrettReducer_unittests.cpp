@@ -0,0 +1,74 @@
+#include "pch.h"
+#include "../../lib/SimpleBigNum/include/barrettReducer.h"
+
+using namespace sbn;
+
+class BarrettReducerUnittests : public BaseTestWithRandomBigNums
+{
+};
+
+TEST_F( BarrettReducerUnittests, div_mod_should_match_div_mod_of_big_num )
+{
+    for( uint32_t i = 0; i < 100; ++i )
+    {
+        const SimpleBigNum divisor = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 2000 ) + 1 );
+        const BarrettReducer reducer( divisor );
+        ASSERT_EQ( reducer.GetDivisor(), divisor );
+
+        // Numbers shorter then the divisor, up to its square and much longer.
+        for( uint32_t j = 0; j < 10; ++j )
+        {
+            const SimpleBigNum number = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % ( 5 * divisor.GetNumberOfDigits() ) ) + 1 );
+
+            SimpleBigNum wantedQuotient;
+            SimpleBigNum wantedRemainder;
+            number.DivMod( divisor, wantedQuotient, wantedRemainder );
+
+            SimpleBigNum quotient;
+            SimpleBigNum remainder;
+            reducer.DivMod( number, quotient, remainder );
+            ASSERT_EQ( quotient, wantedQuotient );
+            ASSERT_EQ( remainder, wantedRemainder );
+        }
+    }
+}
+
+TEST_F( BarrettReducerUnittests, divide_and_mod_should_work_inplace )
+{
+    const SimpleBigNum divisor = GetNextRandomBigNum( 1000 );
+    const BarrettReducer reducer( divisor );
+
+    for( uint32_t i = 0; i < 100; ++i )
+    {
+        const SimpleBigNum number = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 3000 ) + 1 );
+
+        SimpleBigNum quotient = number;
+        reducer.Divide( quotient );
+        SimpleBigNum wantedQuotient = number;
+        wantedQuotient /= divisor;
+        ASSERT_EQ( quotient, wantedQuotient );
+
+        SimpleBigNum remainder = number;
+        reducer.Mod( remainder );
+        SimpleBigNum wantedRemainder = number;
+        wantedRemainder %= divisor;
+        ASSERT_EQ( remainder, wantedRemainder );
+    }
+}
+
+TEST_F( BarrettReducerUnittests, remainder_of_maximal_number_should_be_exact )
+{
+    // ( B^2n - 1 ) is the biggest number reduced in a single step.
+    SimpleBigNum::TRawNumberDigits divisorDigits( 1024, 0xFF );
+    divisorDigits.front() = 0xFE;
+    const SimpleBigNum divisor( divisorDigits.begin(), divisorDigits.end() );
+    const BarrettReducer reducer( divisor );
+
+    SimpleBigNum::TRawNumberDigits numberDigits( 2048, 0xFF );
+    SimpleBigNum number( numberDigits.begin(), numberDigits.end() );
+    SimpleBigNum wantedRemainder = number;
+    wantedRemainder %= divisor;
+
+    reducer.Mod( number );
+    ASSERT_EQ( number, wantedRemainder );
+}
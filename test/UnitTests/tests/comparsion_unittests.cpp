@@ -32,4 +32,27 @@ TEST_F( ComparsionUnittests, stochastic_greater_less_comparsion_stochastic_test
         ASSERT_TRUE( biggerNum > smallerNum );
         ASSERT_TRUE( smallerNum < biggerNum );
     }
-}
\ No newline at end of file
+}
+
+TEST_F( ComparsionUnittests, scalar_comparsion_stochastic_test )
+{
+    for( uint32_t i = 0; i < 10000; ++i )
+    {
+        const auto value1 = GetNextRandomNumber();
+        const auto value2 = i % 10 == 0 ? value1 : GetNextRandomNumber();
+        const SimpleBigNum bigNumber( value1 );
+
+        ASSERT_EQ( bigNumber > value2, value1 > value2 );
+        ASSERT_EQ( bigNumber < value2, value1 < value2 );
+        ASSERT_EQ( bigNumber >= value2, value1 >= value2 );
+        ASSERT_EQ( bigNumber <= value2, value1 <= value2 );
+        ASSERT_EQ( bigNumber == value2, value1 == value2 );
+        ASSERT_EQ( bigNumber != value2, value1 != value2 );
+    }
+
+    // Multi limb numbers are always greater.
+    SimpleBigNum bigNumber( 0xFFFFFFFFFFFFFFFF );
+    bigNumber += 1;
+    ASSERT_TRUE( bigNumber > 0xFFFFFFFFFFFFFFFF );
+    ASSERT_FALSE( bigNumber == 0 );
+}
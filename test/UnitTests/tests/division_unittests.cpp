@@ -17,6 +17,37 @@ public:
         // Compared against https://www.calculator.net/big-number-calculator.html
         ASSERT_EQ( number.ToString( true ), wantedResult );
     }
+
+    // Returns random digits with the top bit set. Long runs of 0x00 and 0xFF bytes make quotient digit estimates hit their corner cases.
+    SimpleBigNum::TRawNumberDigits GetNextRandomDigits( uint32_t size )
+    {
+        SimpleBigNum::TRawNumberDigits digits( size );
+        const uint64_t pattern = GetNextRandomNumber() % 3;
+        for( auto& digit : digits )
+        {
+            const uint64_t random = GetNextRandomNumber();
+            digit = ( pattern == 0 || random % 4 != 0 ) ? ( uint8_t )random : ( pattern == 1 ? 0xFF : 0x00 );
+        }
+        digits.back() |= 0x80;
+        digits.back() >>= GetNextRandomNumber() % 8;
+        return digits;
+    }
+
+    // Checks, that 0 <= number - quotient * divisor < divisor.
+    void performExactDivisionTest( const SimpleBigNum::TRawNumberDigits& numberDigits, const SimpleBigNum::TRawNumberDigits& divisorDigits )
+    {
+        const SimpleBigNum number( numberDigits.begin(), numberDigits.end() );
+        const SimpleBigNum divisor( divisorDigits.begin(), divisorDigits.end() );
+        SimpleBigNum quotient = number;
+        quotient /= divisor;
+
+        SimpleBigNum restored = quotient;
+        restored *= divisor;
+        ASSERT_TRUE( restored <= number );
+        SimpleBigNum remainder = number;
+        remainder -= restored;
+        ASSERT_TRUE( remainder < divisor );
+    }
 };
 
 TEST_F( DivisionUnittests, division_by_one_should_always_give_same_number )
@@ -149,4 +180,176 @@ TEST_F( DivisionUnittests, divisions_stochastic_test )
 
         ASSERT_EQ( bigNumber.ToString(), std::to_string( mult ) );
     }
-}
\ No newline at end of file
+}
+
+TEST_F( DivisionUnittests, div_mod_by_digit_should_give_exact_quotient_and_remainder )
+{
+    const uint64_t specialDivisors[] = { 1, 2, 3, 10, 0x8000000000000000, 0xFFFFFFFFFFFFFFFF, 0x100000000 };
+
+    for( uint32_t i = 0; i < 1000; ++i )
+    {
+        SimpleBigNum::TRawNumberDigits digits( GetNextRandomNumber() % 100 + 1 );
+        for( auto& digit : digits )
+            digit = ( uint8_t )GetNextRandomNumber();
+
+        const uint64_t divisor = i < 7 ? specialDivisors[ i ] : GetNextRandomNumber() >> ( GetNextRandomNumber() % 64 );
+        if( divisor == 0 )
+            continue;
+
+        const SimpleBigNum number( digits.begin(), digits.end() );
+        SimpleBigNum quotient = number;
+        const uint64_t remainder = quotient.DivMod( divisor );
+        ASSERT_LT( remainder, divisor );
+
+        // number == quotient * divisor + remainder
+        SimpleBigNum restored = quotient;
+        restored *= divisor;
+        restored += remainder;
+        ASSERT_EQ( restored, number );
+    }
+}
+
+TEST_F( DivisionUnittests, div_mod_by_zero_should_give_zero )
+{
+    SimpleBigNum number( GetNextRandomNumber() );
+    ASSERT_EQ( number.DivMod( 0 ), 0 );
+    ASSERT_TRUE( number.IsZero() );
+}
+
+TEST_F( DivisionUnittests, division_by_multi_limb_number_should_give_exact_quotient )
+{
+    // Limbs: number = { 0, B-2, 0, B/2 }, divisor = { B-1, 0, B/2 }. Estimate of the first quotient digit is one too big
+    // even after correction with the second digit of the divisor, so the divisor has to be added back.
+    SimpleBigNum::TRawNumberDigits addBackNumberDigits( 32, 0 );
+    SimpleBigNum::TRawNumberDigits addBackDivisorDigits( 24, 0 );
+    std::fill( addBackNumberDigits.begin() + 8, addBackNumberDigits.begin() + 16, ( uint8_t )0xFF );
+    addBackNumberDigits[ 8 ] = 0xFE;
+    addBackNumberDigits.back() = 0x80;
+    std::fill( addBackDivisorDigits.begin(), addBackDivisorDigits.begin() + 8, ( uint8_t )0xFF );
+    addBackDivisorDigits.back() = 0x80;
+    performExactDivisionTest( addBackNumberDigits, addBackDivisorDigits );
+
+    for( uint32_t i = 0; i < 2000; ++i )
+    {
+        const uint32_t divisorSize = ( uint32_t )( GetNextRandomNumber() % 300 ) + 9;
+        const uint32_t numberSize = divisorSize + ( uint32_t )( GetNextRandomNumber() % 300 );
+        performExactDivisionTest( GetNextRandomDigits( numberSize ), GetNextRandomDigits( divisorSize ) );
+    }
+}
+
+TEST_F( DivisionUnittests, division_by_long_number_should_give_exact_quotient )
+{
+    // Number = ( divisor - 1 ) * 256^1024 + low. Top halves of the partial remainder and the divisor are equal,
+    // so the quotient of the recursive step cannot be estimated by the division of the top halves.
+    auto divisorDigits = GetNextRandomDigits( 1024 );
+    divisorDigits.back() |= 0x80;
+    const SimpleBigNum divisor( divisorDigits.begin(), divisorDigits.end() );
+    const auto lowDigits = GetNextRandomDigits( 1024 );
+    SimpleBigNum number = divisor;
+    number -= 1;
+    number << 1024;
+    number += SimpleBigNum( lowDigits.begin(), lowDigits.end() );
+
+    SimpleBigNum quotient = number;
+    quotient /= divisor;
+    SimpleBigNum restored = quotient;
+    restored *= divisor;
+    ASSERT_TRUE( restored <= number );
+    number -= restored;
+    ASSERT_TRUE( number < divisor );
+
+    // Divisors and quotients are long enough to be divided recursively.
+    for( uint32_t i = 0; i < 60; ++i )
+    {
+        const uint32_t divisorSize = 8 * ( ( uint32_t )( GetNextRandomNumber() % 2000 ) + 80 );
+        const uint32_t numberSize = divisorSize + 8 * ( ( uint32_t )( GetNextRandomNumber() % 4000 ) + 80 );
+        performExactDivisionTest( GetNextRandomDigits( numberSize ), GetNextRandomDigits( divisorSize ) );
+    }
+}
+
+TEST_F( DivisionUnittests, division_by_very_long_number_should_give_exact_quotient )
+{
+    // Divisors are long enough to be divided using reciprocal.
+    for( uint32_t i = 0; i < 2; ++i )
+    {
+        const uint32_t divisorSize = 8 * ( ( uint32_t )( GetNextRandomNumber() % 4000 ) + 20000 );
+        const uint32_t numberSize = divisorSize + 8 * ( ( uint32_t )( GetNextRandomNumber() % 20000 ) + 1 );
+        performExactDivisionTest( GetNextRandomDigits( numberSize ), GetNextRandomDigits( divisorSize ) );
+    }
+}
+
+TEST_F( DivisionUnittests, div_mod_should_give_quotient_and_remainder )
+{
+    for( uint32_t i = 0; i < 300; ++i )
+    {
+        const uint32_t divisorSize = ( uint32_t )( GetNextRandomNumber() % 3000 ) + 1;
+        const uint32_t numberSize = ( uint32_t )( GetNextRandomNumber() % 6000 ) + 1;
+        const auto numberDigits = GetNextRandomDigits( numberSize );
+        const auto divisorDigits = GetNextRandomDigits( divisorSize );
+        const SimpleBigNum number( numberDigits.begin(), numberDigits.end() );
+        const SimpleBigNum divisor( divisorDigits.begin(), divisorDigits.end() );
+        if( divisor.IsZero() )
+            continue;
+
+        SimpleBigNum quotient;
+        SimpleBigNum remainder;
+        number.DivMod( divisor, quotient, remainder );
+        ASSERT_TRUE( remainder < divisor );
+
+        SimpleBigNum wantedQuotient = number;
+        wantedQuotient /= divisor;
+        ASSERT_EQ( quotient, wantedQuotient );
+
+        // number == quotient * divisor + remainder
+        SimpleBigNum restored = quotient;
+        restored *= divisor;
+        restored += remainder;
+        ASSERT_EQ( restored, number );
+
+        SimpleBigNum modulo = number;
+        modulo %= divisor;
+        ASSERT_EQ( modulo, remainder );
+    }
+}
+
+TEST_F( DivisionUnittests, div_mod_should_allow_divisor_as_output )
+{
+    const SimpleBigNum number( 1000003 );
+    SimpleBigNum quotient( 10 );
+    SimpleBigNum remainder;
+    number.DivMod( quotient, quotient, remainder );
+    ASSERT_EQ( quotient, 100000 );
+    ASSERT_EQ( remainder, 3 );
+
+    SimpleBigNum divisor( 7 );
+    SimpleBigNum otherQuotient;
+    number.DivMod( divisor, otherQuotient, divisor );
+    ASSERT_EQ( otherQuotient, 142857 );
+    ASSERT_EQ( divisor, 4 );
+}
+
+TEST_F( DivisionUnittests, mod_by_itself_or_zero_should_give_zero )
+{
+    SimpleBigNum number( GetNextRandomNumber() | 1 );
+    number %= number;
+    ASSERT_TRUE( number.IsZero() );
+
+    SimpleBigNum otherNumber( GetNextRandomNumber() );
+    otherNumber %= SimpleBigNum();
+    ASSERT_TRUE( otherNumber.IsZero() );
+}
+
+TEST_F( DivisionUnittests, mod_by_digit_should_match_div_mod )
+{
+    for( uint32_t i = 0; i < 1000; ++i )
+    {
+        const auto digits = GetNextRandomDigits( ( uint32_t )( GetNextRandomNumber() % 100 ) + 1 );
+        const uint64_t divisor = GetNextRandomNumber() >> ( GetNextRandomNumber() % 64 );
+        SimpleBigNum number( digits.begin(), digits.end() );
+        SimpleBigNum quotient = number;
+        const uint64_t remainder = quotient.DivMod( divisor );
+
+        number %= divisor;
+        ASSERT_EQ( number, remainder );
+    }
+}
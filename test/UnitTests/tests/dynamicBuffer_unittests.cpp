@@ -70,4 +70,29 @@ TEST( AllocatorUnitests, move_operation )
     for( int i = 0; i < 1000; ++i )
         ASSERT_TRUE( buffer2.At( i ) == i );
 
-}
\ No newline at end of file
+}
+
+TEST( AllocatorUnitests, padding_should_be_aligned_and_zeroed )
+{
+    sbn::tools::AlignedAllocator allocator;
+    sbn::tools::DynamicBuffer< uint64_t > buffer( allocator );
+
+    for( uint64_t i = 0; i < 1000; ++i )
+    {
+        buffer.PushBack( ~i );
+
+        ASSERT_TRUE( ( sbn::tools::isAligned< uintptr_t, sbn::tools::SIMD_ALIGNMENT >( ( uintptr_t )buffer.Data() ) ) );
+        ASSERT_TRUE( ( buffer.Capacity() * sizeof( uint64_t ) ) % sbn::tools::SIMD_ALIGNMENT == 0 );
+    }
+
+    buffer.Resize( 501 );
+    sbn::tools::DynamicBuffer< uint64_t > copy( buffer );
+
+    for( size_t i = 501; i < buffer.Capacity(); ++i )
+        ASSERT_TRUE( buffer.At( i ) == 0 );
+
+    for( size_t i = 501; i < copy.Capacity(); ++i )
+        ASSERT_TRUE( copy.At( i ) == 0 );
+
+    ASSERT_TRUE( copy.IsEqualTo( buffer ) );
+}
@@ -0,0 +1,183 @@
+#include "pch.h"
+
+using namespace sbn;
+
+class GcdUnittests : public BaseTestWithRandomBigNums
+{
+public:
+    // Checks, that gcd divides both numbers and a * x - b * y = gcd, so every common divisor divides gcd.
+    static void CheckExtendedGcd( const SimpleBigNum& a, const SimpleBigNum& b, const SimpleBigNum& gcd, const SimpleBigNum& x, const SimpleBigNum& y )
+    {
+        SimpleBigNum remainder = a;
+        remainder %= gcd;
+        ASSERT_TRUE( remainder.IsZero() );
+        remainder = b;
+        remainder %= gcd;
+        ASSERT_TRUE( remainder.IsZero() );
+
+        SimpleBigNum maxX = b;
+        maxX /= gcd;
+        SimpleBigNum maxY = a;
+        maxY /= gcd;
+        ASSERT_TRUE( x >= 1 );
+        ASSERT_TRUE( x <= maxX );
+        ASSERT_TRUE( y < maxY );
+
+        SimpleBigNum ax = a;
+        ax *= x;
+        SimpleBigNum by = b;
+        by *= y;
+        by += gcd;
+        ASSERT_EQ( ax, by );
+    }
+
+    void PerformRandomTest( uint32_t aDigits, uint32_t bDigits, uint32_t commonDigits )
+    {
+        SimpleBigNum a = GetNextRandomBigNum( aDigits );
+        SimpleBigNum b = GetNextRandomBigNum( bDigits );
+        if( commonDigits > 0 )
+        {
+            const SimpleBigNum common = GetNextRandomBigNum( commonDigits );
+            a *= common;
+            b *= common;
+        }
+
+        SimpleBigNum gcd = a;
+        SimpleBigNum x;
+        SimpleBigNum y;
+        gcd.ExtendedGcd( b, x, y );
+        CheckExtendedGcd( a, b, gcd, x, y );
+
+        SimpleBigNum plainGcd = a;
+        plainGcd.Gcd( b );
+        ASSERT_EQ( plainGcd, gcd );
+    }
+};
+
+TEST_F( GcdUnittests, trivial_cases )
+{
+    SimpleBigNum number = 0;
+    number.Gcd( 0 );
+    ASSERT_EQ( number, 0 );
+
+    number = 0;
+    number.Gcd( 15 );
+    ASSERT_EQ( number, 15 );
+
+    number = 15;
+    number.Gcd( 0 );
+    ASSERT_EQ( number, 15 );
+
+    number = 12;
+    number.Gcd( 18 );
+    ASSERT_EQ( number, 6 );
+
+    number = 17;
+    number.Gcd( 17 );
+    ASSERT_EQ( number, 17 );
+
+    SimpleBigNum x;
+    SimpleBigNum y;
+    number = 15;
+    number.ExtendedGcd( 0, x, y );
+    ASSERT_EQ( number, 15 );
+    ASSERT_EQ( x, 1 );
+    ASSERT_EQ( y, 0 );
+
+    number = 0;
+    number.ExtendedGcd( 15, x, y );
+    ASSERT_EQ( number, 15 );
+    ASSERT_EQ( x, 0 );
+    ASSERT_EQ( y, 0 );
+
+    number = 6;
+    number.ExtendedGcd( 3, x, y );
+    ASSERT_EQ( number, 3 );
+    ASSERT_EQ( x, 1 );
+    ASSERT_EQ( y, 1 );
+
+    number = 240;
+    number.ExtendedGcd( 46, x, y );
+    ASSERT_EQ( number, 2 );
+    CheckExtendedGcd( 240, 46, number, x, y );
+}
+
+TEST_F( GcdUnittests, gcd_of_random_numbers )
+{
+    for( uint32_t i = 0; i < 300; ++i )
+    {
+        const uint32_t aDigits = ( uint32_t )( GetNextRandomNumber() % 200 ) + 1;
+        const uint32_t bDigits = i % 3 == 0 ? ( uint32_t )( GetNextRandomNumber() % 200 ) + 1 : aDigits;
+        PerformRandomTest( aDigits, bDigits, ( uint32_t )( GetNextRandomNumber() % 50 ) );
+    }
+}
+
+TEST_F( GcdUnittests, gcd_of_long_numbers )
+{
+    // Numbers above a few hundred limbs are reduced using half-gcd.
+    for( uint32_t i = 0; i < 12; ++i )
+    {
+        const uint32_t aDigits = ( uint32_t )( GetNextRandomNumber() % 20000 ) + 1000;
+        const uint32_t bDigits = i % 4 == 0 ? ( uint32_t )( GetNextRandomNumber() % 20000 ) + 1000 : aDigits - ( uint32_t )( GetNextRandomNumber() % 16 );
+        PerformRandomTest( aDigits, bDigits, i % 2 == 0 ? ( uint32_t )( GetNextRandomNumber() % 5000 ) + 1 : 0 );
+    }
+}
+
+TEST_F( GcdUnittests, gcd_of_fibonacci_numbers )
+{
+    // Consecutive Fibonacci numbers have all quotients equal to one.
+    SimpleBigNum previous = 1;
+    SimpleBigNum current = 1;
+    for( uint32_t i = 0; i < 60000; ++i )
+    {
+        SimpleBigNum next = previous;
+        next += current;
+        previous = std::move( current );
+        current = std::move( next );
+    }
+
+    SimpleBigNum gcd = current;
+    SimpleBigNum x;
+    SimpleBigNum y;
+    gcd.ExtendedGcd( previous, x, y );
+    ASSERT_EQ( gcd, 1 );
+    CheckExtendedGcd( current, previous, gcd, x, y );
+}
+
+TEST_F( GcdUnittests, mod_inverse )
+{
+    SimpleBigNum number = 3;
+    ASSERT_TRUE( number.ModInverse( 7 ) );
+    ASSERT_EQ( number, 5 );
+
+    number = 6;
+    ASSERT_FALSE( number.ModInverse( 9 ) );
+    ASSERT_EQ( number, 0 );
+
+    number = 5;
+    ASSERT_TRUE( number.ModInverse( 1 ) );
+    ASSERT_EQ( number, 0 );
+
+    number = 5;
+    ASSERT_FALSE( number.ModInverse( 0 ) );
+
+    for( uint32_t i = 0; i < 100; ++i )
+    {
+        const SimpleBigNum modulus = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % ( i % 10 == 0 ? 5000 : 200 ) ) + 1 );
+        const SimpleBigNum original = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 300 ) + 1 );
+
+        SimpleBigNum gcd = original;
+        gcd.Gcd( modulus );
+        SimpleBigNum inverse = original;
+        const bool isInvertible = inverse.ModInverse( modulus );
+        ASSERT_EQ( isInvertible, gcd.IsOne() );
+        if( !isInvertible )
+            continue;
+
+        ASSERT_TRUE( inverse < modulus );
+        SimpleBigNum product = inverse;
+        product *= original;
+        product %= modulus;
+        ASSERT_EQ( product, modulus.IsOne() ? 0 : 1 );
+    }
+}
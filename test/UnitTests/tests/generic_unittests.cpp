@@ -123,4 +123,20 @@ TEST( GenericUnittests, fibonacci_modified )
         "40440075332448118515289644187718277000465073331266220092658042926961800091782548"
         "63182597354583972014051796126298711430876296060577478064359879155901089639865701"
         "56087004776466078987255481357174321182" );
-}
\ No newline at end of file
+}
+
+TEST( GenericUnittests, moved_from_number_is_zero )
+{
+    sbn::SimpleBigNum number( 12345 );
+    number *= number;
+    number *= number;
+
+    sbn::SimpleBigNum movedNumber( std::move( number ) );
+    ASSERT_EQ( movedNumber.ToString(), "23225462820950625" );
+    ASSERT_TRUE( number.IsZero() );
+    ASSERT_EQ( number.GetNumberOfDigits(), 1u );
+    ASSERT_EQ( number.ToString(), "0" );
+
+    number += 7;
+    ASSERT_EQ( number, 7 );
+}
@@ -0,0 +1,86 @@
+#include "pch.h"
+#include "../../lib/SimpleBigNum/src/karatsubaMultiplier/karatsubaMultiplier.h"
+#include "../../lib/SimpleBigNum/src/arithmeticImpl/arithmeticImpl.h"
+
+using namespace sbn;
+using namespace sbn::internal;
+
+class KaratsubaMultiplierUnittests : public BaseTestWithRandomGenerator< uint64_t >
+{
+public:
+    KaratsubaMultiplierUnittests() : BaseTestWithRandomGenerator( 0, 0xFFFFFFFFFFFFFFFF ) {}
+
+    std::vector< uint64_t > GetNextRandomLimbs( uint32_t size )
+    {
+        std::vector< uint64_t > limbs( size );
+        for( auto& limb : limbs )
+        {
+            const uint64_t random = GetNextRandomNumber();
+            limb = ( random % 3 == 0 ) ? 0xFFFFFFFFFFFFFFFF : ( random % 3 == 1 ? 0 : GetNextRandomNumber() );
+        }
+        return limbs;
+    }
+
+    static constexpr uint64_t GUARD = 0xDEADBEEFDEADBEEF;
+    static constexpr uint32_t GUARD_SIZE = 8;
+
+    // Checks, that nothing was written past the first size limbs.
+    static bool IsGuardIntact( const std::vector< uint64_t >& buffer, uint32_t size )
+    {
+        return std::all_of( buffer.begin() + size, buffer.end(), []( uint64_t limb ) { return limb == GUARD; } );
+    }
+};
+
+TEST_F( KaratsubaMultiplierUnittests, multiplication_should_match_basecase_multiplication )
+{
+    for( uint32_t i = 0; i < 300; ++i )
+    {
+        const uint32_t aSize = ( uint32_t )( GetNextRandomNumber() % 800 ) + 1;
+        const uint32_t bSize = ( i % 3 == 0 ) ? aSize : ( uint32_t )( GetNextRandomNumber() % aSize ) + 1;
+        const std::vector< uint64_t > a = GetNextRandomLimbs( aSize );
+        const std::vector< uint64_t > b = GetNextRandomLimbs( bSize );
+
+        std::vector< uint64_t > wantedProduct( aSize + bSize, 0 );
+        MultiplyInplaceImpl( a.data(), aSize, b.data(), bSize, wantedProduct.data() );
+
+        // Result does not have to be zeroed and scratch may contain anything.
+        const uint32_t scratchSize = KaratsubaMultiplier::GetMultiplyScratchSize( aSize );
+        std::vector< uint64_t > product( aSize + bSize + GUARD_SIZE, GUARD );
+        std::vector< uint64_t > scratch( scratchSize + GUARD_SIZE, GUARD );
+        KaratsubaMultiplier::Multiply( a.data(), aSize, b.data(), bSize, product.data(), scratch.data() );
+
+        ASSERT_TRUE( std::equal( wantedProduct.begin(), wantedProduct.end(), product.begin() ) );
+        ASSERT_TRUE( IsGuardIntact( product, aSize + bSize ) );
+        ASSERT_TRUE( IsGuardIntact( scratch, scratchSize ) );
+    }
+}
+
+TEST_F( KaratsubaMultiplierUnittests, square_should_match_basecase_multiplication )
+{
+    for( uint32_t i = 0; i < 300; ++i )
+    {
+        const uint32_t size = ( uint32_t )( GetNextRandomNumber() % 800 ) + 1;
+        const std::vector< uint64_t > number = GetNextRandomLimbs( size );
+
+        std::vector< uint64_t > wantedSquare( 2 * size, 0 );
+        MultiplyInplaceImpl( number.data(), size, number.data(), size, wantedSquare.data() );
+
+        const uint32_t scratchSize = KaratsubaMultiplier::GetSquareScratchSize( size );
+        std::vector< uint64_t > square( 2 * size + GUARD_SIZE, GUARD );
+        std::vector< uint64_t > scratch( scratchSize + GUARD_SIZE, GUARD );
+        KaratsubaMultiplier::Square( number.data(), size, square.data(), scratch.data() );
+
+        ASSERT_TRUE( std::equal( wantedSquare.begin(), wantedSquare.end(), square.begin() ) );
+        ASSERT_TRUE( IsGuardIntact( square, 2 * size ) );
+        ASSERT_TRUE( IsGuardIntact( scratch, scratchSize ) );
+    }
+}
+
+TEST_F( KaratsubaMultiplierUnittests, scratch_size_should_be_about_two_times_operand_size )
+{
+    for( uint32_t size = 1; size < 100000; size = size * 3 / 2 + 1 )
+    {
+        ASSERT_LE( KaratsubaMultiplier::GetMultiplyScratchSize( size ), 2 * size + 64 );
+        ASSERT_LE( KaratsubaMultiplier::GetSquareScratchSize( size ), 2 * size + 64 );
+    }
+}
@@ -0,0 +1,90 @@
+#include "pch.h"
+#include "../../lib/SimpleBigNum/include/montgomeryContext.h"
+
+using namespace sbn;
+
+class MontgomeryContextUnittests : public BaseTestWithRandomBigNums
+{
+public:
+    // Returns random odd number with exactly numberOfDigits digits.
+    SimpleBigNum GetNextRandomModulus( uint32_t numberOfDigits )
+    {
+        SimpleBigNum modulus = GetNextRandomBigNum( numberOfDigits );
+        SimpleBigNum parity = modulus;
+        parity.Mod( 2 );
+        if( parity.IsZero() )
+            modulus += 1;
+        return modulus;
+    }
+};
+
+TEST_F( MontgomeryContextUnittests, conversion_should_give_back_the_same_number )
+{
+    for( uint32_t i = 0; i < 200; ++i )
+    {
+        const SimpleBigNum modulus = GetNextRandomModulus( ( uint32_t )( GetNextRandomNumber() % 500 ) + 1 );
+        const MontgomeryContext context( modulus );
+        ASSERT_EQ( context.GetModulus(), modulus );
+
+        SimpleBigNum wantedNumber = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 500 ) + 1 );
+        SimpleBigNum number = wantedNumber;
+        context.ToMontgomeryForm( number );
+        ASSERT_TRUE( number < modulus );
+        context.FromMontgomeryForm( number );
+
+        wantedNumber %= modulus;
+        ASSERT_EQ( number, wantedNumber );
+    }
+}
+
+TEST_F( MontgomeryContextUnittests, mul_mod_and_sqr_mod_should_match_multiplication_and_modulo )
+{
+    for( uint32_t i = 0; i < 200; ++i )
+    {
+        const SimpleBigNum modulus = GetNextRandomModulus( ( uint32_t )( GetNextRandomNumber() % 500 ) + 1 );
+        const MontgomeryContext context( modulus );
+
+        SimpleBigNum number = GetNextRandomBigNum( modulus.GetNumberOfDigits() );
+        SimpleBigNum other = GetNextRandomBigNum( modulus.GetNumberOfDigits() );
+        number %= modulus;
+        other %= modulus;
+
+        SimpleBigNum wantedProduct = number;
+        wantedProduct *= other;
+        wantedProduct %= modulus;
+        SimpleBigNum wantedSquare = number;
+        wantedSquare.Square();
+        wantedSquare %= modulus;
+
+        context.ToMontgomeryForm( number );
+        context.ToMontgomeryForm( other );
+        SimpleBigNum product = number;
+        context.MulMod( product, other );
+        context.FromMontgomeryForm( product );
+        ASSERT_EQ( product, wantedProduct );
+
+        SimpleBigNum square = number;
+        context.SqrMod( square );
+        context.FromMontgomeryForm( square );
+        ASSERT_EQ( square, wantedSquare );
+    }
+}
+
+TEST_F( MontgomeryContextUnittests, reduction_of_maximal_numbers_should_not_lose_carry )
+{
+    // Modulus B^n - 1 makes every row of the reduction carry into the next one.
+    const SimpleBigNum::TRawNumberDigits modulusDigits( 64, 0xFF );
+    const SimpleBigNum modulus( modulusDigits.begin(), modulusDigits.end() );
+    const MontgomeryContext context( modulus );
+
+    SimpleBigNum number = modulus;
+    number -= 1;
+    SimpleBigNum wantedSquare = number;
+    wantedSquare.Square();
+    wantedSquare %= modulus;
+
+    context.ToMontgomeryForm( number );
+    context.SqrMod( number );
+    context.FromMontgomeryForm( number );
+    ASSERT_EQ( number, wantedSquare );
+}
@@ -6,6 +6,34 @@ class MultiplicationUnittests : public BaseTestWithRandomGenerator< uint64_t >
 {
 public:
     MultiplicationUnittests() : BaseTestWithRandomGenerator( 0, 0xFFFFFFFF ) {}
+
+    // Returns random digits, half of which are equal to 255, so carries are propagated over long distances.
+    SimpleBigNum::TRawNumberDigits GetNextRandomDigits( uint32_t size )
+    {
+        SimpleBigNum::TRawNumberDigits digits( size );
+        for( auto& digit : digits )
+            digit = GetNextRandomNumber() % 2 == 0 ? 255 : ( uint8_t )GetNextRandomNumber();
+        return digits;
+    }
+
+    // Returns number1 * number2 calculated as sum of number1 * limb * 256^limbOffset over all 64 bit limbs of number2.
+    static SimpleBigNum MultiplySchoolbook( const SimpleBigNum& number1, const SimpleBigNum::TRawNumberDigits& digits2 )
+    {
+        SimpleBigNum product;
+        for( size_t limbOffset = 0; limbOffset < digits2.size(); limbOffset += 8 )
+        {
+            uint64_t limb = 0;
+            for( size_t digitIdx = std::min( limbOffset + 8, digits2.size() ); digitIdx > limbOffset; --digitIdx )
+                limb = ( limb << 8 ) | digits2[ digitIdx - 1 ];
+
+            SimpleBigNum partialProduct = number1;
+            partialProduct *= limb;
+            partialProduct << ( uint32_t )limbOffset;
+            product += partialProduct;
+        }
+
+        return product;
+    }
 };
 
 TEST_F( MultiplicationUnittests, multiplication_by_zero_should_always_give_zero )
@@ -102,4 +130,155 @@ TEST_F( MultiplicationUnittests, factorial_calculation )
         "000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,"
         "000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,"
         "000,000,000,000,000,000,000,000,000,000,000,000,000,000,000,000" );
-}
\ No newline at end of file
+}
+
+TEST_F( MultiplicationUnittests, squaring_should_give_same_result_as_multiplication )
+{
+    for( uint32_t i = 0; i < 200; ++i )
+    {
+        // Sizes cover both basecase and Karatsuba squaring, digits are often 255 to stress carries.
+        SimpleBigNum::TRawNumberDigits rawDigits( GetNextRandomNumber() % 3000 + 1 );
+        for( auto& digit : rawDigits )
+            digit = GetNextRandomNumber() % 2 == 0 ? 255 : ( uint8_t )GetNextRandomNumber();
+
+        const SimpleBigNum number( rawDigits.begin(), rawDigits.end() );
+        const SimpleBigNum copy = number;
+
+        SimpleBigNum wantedSquare = number;
+        wantedSquare *= copy;
+
+        SimpleBigNum square = number;
+        square.Square();
+        ASSERT_EQ( square, wantedSquare );
+
+        SimpleBigNum selfProduct = number;
+        selfProduct *= selfProduct;
+        ASSERT_EQ( selfProduct, wantedSquare );
+    }
+}
+
+TEST_F( MultiplicationUnittests, scalar_multiplication_should_match_big_number_multiplication )
+{
+    for( uint32_t i = 0; i < 1000; ++i )
+    {
+        const SimpleBigNum::TRawNumberDigits digits = GetNextRandomDigits( GetNextRandomNumber() % 200 + 1 );
+
+        const uint64_t value = ( GetNextRandomNumber() << 32 ) | GetNextRandomNumber();
+        SimpleBigNum wanted( digits.begin(), digits.end() );
+        wanted *= SimpleBigNum( value );
+
+        SimpleBigNum bigNumber( digits.begin(), digits.end() );
+        bigNumber *= value;
+        ASSERT_EQ( bigNumber, wanted );
+    }
+}
+
+TEST_F( MultiplicationUnittests, big_multiplications_should_match_schoolbook_multiplication )
+{
+    // Sizes go through Karatsuba, Toom-3 and Toom-4 tiers, including unbalanced operands.
+    for( uint32_t i = 0; i < 30; ++i )
+    {
+        const SimpleBigNum::TRawNumberDigits digits1 = GetNextRandomDigits( GetNextRandomNumber() % 12000 + 1 );
+        const SimpleBigNum::TRawNumberDigits digits2 = GetNextRandomDigits( GetNextRandomNumber() % 12000 + 1 );
+
+        const SimpleBigNum number1( digits1.begin(), digits1.end() );
+        const SimpleBigNum number2( digits2.begin(), digits2.end() );
+        const SimpleBigNum wanted = MultiplySchoolbook( number1, digits2 );
+
+        SimpleBigNum product = number1;
+        product *= number2;
+        ASSERT_EQ( product, wanted );
+    }
+}
+
+TEST_F( MultiplicationUnittests, unbalanced_multiplications_should_match_schoolbook_multiplication )
+{
+    // Smaller numbers are long enough for Toom and NTT, bigger ones are sliced into chunks with shorter last chunk.
+    for( uint32_t i = 0; i < 12; ++i )
+    {
+        const uint32_t smallerDigits = ( i < 8 ) ? GetNextRandomNumber() % 4000 + 1200 : GetNextRandomNumber() % 4000 + 13000;
+        const uint32_t biggerDigits = smallerDigits * ( GetNextRandomNumber() % 6 + 2 ) + GetNextRandomNumber() % smallerDigits;
+        const SimpleBigNum::TRawNumberDigits smallerRawDigits = GetNextRandomDigits( smallerDigits );
+        const SimpleBigNum::TRawNumberDigits biggerRawDigits = GetNextRandomDigits( biggerDigits );
+
+        const SimpleBigNum smaller( smallerRawDigits.begin(), smallerRawDigits.end() );
+        const SimpleBigNum bigger( biggerRawDigits.begin(), biggerRawDigits.end() );
+        const SimpleBigNum wanted = MultiplySchoolbook( bigger, smallerRawDigits );
+
+        SimpleBigNum product = bigger;
+        product *= smaller;
+        ASSERT_EQ( product, wanted );
+
+        product = smaller;
+        product *= bigger;
+        ASSERT_EQ( product, wanted );
+    }
+}
+
+TEST_F( MultiplicationUnittests, pow_should_match_repeated_multiplication )
+{
+    for( uint32_t i = 0; i < 100; ++i )
+    {
+        // Some bases get trailing zero bits, which are raised to the power as shift.
+        const auto digits = GetNextRandomDigits( GetNextRandomNumber() % ( i % 10 == 0 ? 500 : 100 ) + 1 );
+        SimpleBigNum base( digits.begin(), digits.end() );
+        base *= ( uint64_t )1 << ( GetNextRandomNumber() % 64 );
+        if( i % 4 == 0 )
+            base.ShitfLeft( GetNextRandomNumber() % 20 );
+
+        const uint64_t exponent = GetNextRandomNumber() % 64;
+        SimpleBigNum wantedResult = 1;
+        for( uint64_t j = 0; j < exponent; ++j )
+            wantedResult *= base;
+
+        SimpleBigNum result = base;
+        result.Pow( exponent );
+        ASSERT_EQ( result, wantedResult );
+    }
+}
+
+TEST_F( MultiplicationUnittests, pow_of_power_of_two_should_match_shifting )
+{
+    for( uint32_t bits = 0; bits < 140; ++bits )
+    {
+        SimpleBigNum base = 1;
+        base.ShitfLeft( bits / 8 );
+        base *= 1 << ( bits % 8 );
+
+        const uint32_t exponent = GetNextRandomNumber() % 1000;
+        SimpleBigNum wantedResult = 1;
+        for( uint32_t j = 0; j < bits * exponent; ++j )
+            wantedResult *= 2;
+
+        base.Pow( exponent );
+        ASSERT_EQ( base, wantedResult );
+    }
+}
+
+TEST_F( MultiplicationUnittests, pow_trivial_cases )
+{
+    SimpleBigNum number = 0;
+    number.Pow( 0 );
+    ASSERT_EQ( number, 1 );
+
+    number = 0;
+    number.Pow( 5 );
+    ASSERT_EQ( number, 0 );
+
+    number = 1;
+    number.Pow( 0xFFFFFFFFFFFFFFFF );
+    ASSERT_EQ( number, 1 );
+
+    number = 12345;
+    number.Pow( 1 );
+    ASSERT_EQ( number, 12345 );
+
+    number = 10;
+    number.Pow( 2000 );
+    ASSERT_EQ( number.ToString(), "1" + std::string( 2000, '0' ) );
+
+    // Result with more then 2^32 limbs is zero.
+    number = 2;
+    number.Pow( 0xFFFFFFFFFFFFFFFF );
+    ASSERT_EQ( number, 0 );
+}
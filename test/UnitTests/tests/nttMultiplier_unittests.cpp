@@ -0,0 +1,72 @@
+#include "pch.h"
+#include "../../lib/SimpleBigNum/src/nttMultiplier/nttMultiplier.h"
+#include "../../lib/SimpleBigNum/src/arithmeticImpl/arithmeticImpl.h"
+
+using namespace sbn;
+using namespace sbn::internal;
+
+class NttMultiplierUnittests : public BaseTestWithRandomGenerator< uint64_t >
+{
+public:
+    NttMultiplierUnittests() : BaseTestWithRandomGenerator( 0, 0xFFFFFFFFFFFFFFFF ) {}
+
+    std::vector< uint64_t > GetNextRandomLimbs( uint32_t size )
+    {
+        std::vector< uint64_t > limbs( size );
+        for( auto& limb : limbs )
+            limb = GetNextRandomNumber() % 3 == 0 ? 0xFFFFFFFFFFFFFFFF : GetNextRandomNumber();
+        return limbs;
+    }
+};
+
+TEST_F( NttMultiplierUnittests, multiplication_should_match_basecase_multiplication )
+{
+    for( uint32_t i = 0; i < 100; ++i )
+    {
+        const uint32_t aSize = ( uint32_t )( GetNextRandomNumber() % 1500 ) + 1;
+        const uint32_t bSize = ( i % 2 == 0 ) ? ( uint32_t )( GetNextRandomNumber() % 1500 ) + 1 : ( uint32_t )( GetNextRandomNumber() % 4 ) + 1;
+        const std::vector< uint64_t > a = GetNextRandomLimbs( aSize );
+        const std::vector< uint64_t > b = GetNextRandomLimbs( bSize );
+
+        std::vector< uint64_t > wantedProduct( aSize + bSize, 0 );
+        MultiplyInplaceImpl( a.data(), aSize, b.data(), bSize, wantedProduct.data() );
+
+        std::vector< uint64_t > product( aSize + bSize, 0 );
+        NttMultiplier::Multiply( a.data(), aSize, b.data(), bSize, product.data() );
+        ASSERT_EQ( product, wantedProduct );
+    }
+}
+
+TEST_F( NttMultiplierUnittests, square_should_match_basecase_multiplication )
+{
+    for( uint32_t i = 0; i < 100; ++i )
+    {
+        const uint32_t size = ( uint32_t )( GetNextRandomNumber() % 1500 ) + 1;
+        const std::vector< uint64_t > number = GetNextRandomLimbs( size );
+
+        std::vector< uint64_t > wantedSquare( 2 * size, 0 );
+        MultiplyInplaceImpl( number.data(), size, number.data(), size, wantedSquare.data() );
+
+        std::vector< uint64_t > square( 2 * size, 0 );
+        NttMultiplier::Square( number.data(), size, square.data() );
+        ASSERT_EQ( square, wantedSquare );
+    }
+}
+
+TEST_F( NttMultiplierUnittests, product_of_maximal_limbs_should_not_overflow_coefficients )
+{
+    // All limbs equal to 2^64-1 give the biggest possible convolution coefficients.
+    const uint32_t size = 5000;
+    const std::vector< uint64_t > number( size, 0xFFFFFFFFFFFFFFFF );
+
+    // ( B^n - 1 )^2 = B^2n - 2*B^n + 1
+    std::vector< uint64_t > wantedSquare( 2 * size, 0xFFFFFFFFFFFFFFFF );
+    wantedSquare[ 0 ] = 1;
+    for( uint32_t idx = 1; idx < size; ++idx )
+        wantedSquare[ idx ] = 0;
+    wantedSquare[ size ] = 0xFFFFFFFFFFFFFFFE;
+
+    std::vector< uint64_t > square( 2 * size, 0 );
+    NttMultiplier::Square( number.data(), size, square.data() );
+    ASSERT_EQ( square, wantedSquare );
+}
@@ -0,0 +1,173 @@
+#include "pch.h"
+#include "../../lib/SimpleBigNum/include/fixedBaseExponentiator.h"
+
+using namespace sbn;
+
+class PowModUnittests : public BaseTestWithRandomBigNums
+{
+public:
+    // Returns number^exponent mod modulus calculated using binary exponentiation.
+    static SimpleBigNum SlowPowMod( const SimpleBigNum& number, uint64_t exponent, const SimpleBigNum& modulus )
+    {
+        SimpleBigNum result = 1;
+        SimpleBigNum power = number;
+        power %= modulus;
+        for( ; exponent != 0; exponent >>= 1 )
+        {
+            if( exponent & 1 )
+            {
+                result *= power;
+                result %= modulus;
+            }
+            power.Square();
+            power %= modulus;
+        }
+        result %= modulus;
+        return result;
+    }
+
+    // Returns 2^521 - 1, which is prime.
+    static SimpleBigNum GetMersennePrime()
+    {
+        SimpleBigNum prime = 1;
+        prime.ShitfLeft( 65 );
+        prime *= 2;
+        prime -= 1;
+        return prime;
+    }
+};
+
+TEST_F( PowModUnittests, trivial_cases )
+{
+    SimpleBigNum number = 12345;
+    number.PowMod( 0, 7 );
+    ASSERT_EQ( number, 1 );
+
+    number = 12345;
+    number.PowMod( 0, 1 );
+    ASSERT_EQ( number, 0 );
+
+    number = 12345;
+    number.PowMod( 3, 0 );
+    ASSERT_EQ( number, 0 );
+
+    number = 14;
+    number.PowMod( 5, 7 );
+    ASSERT_EQ( number, 0 );
+
+    number = 3;
+    number.PowMod( 4, 1000 );
+    ASSERT_EQ( number, 81 );
+
+    number = 3;
+    number.PowMod( 5, 7 );
+    ASSERT_EQ( number, 5 );
+}
+
+TEST_F( PowModUnittests, pow_mod_should_match_binary_exponentiation )
+{
+    for( uint32_t i = 0; i < 200; ++i )
+    {
+        // Odd moduli go through Montgomery multiplication, even ones through Barrett reduction.
+        SimpleBigNum modulus = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 100 ) + 1 );
+        if( i % 2 == 0 )
+            modulus *= 2;
+
+        const SimpleBigNum number = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 150 ) + 1 );
+        const uint64_t exponent = GetNextRandomNumber() >> ( GetNextRandomNumber() % 64 );
+
+        SimpleBigNum result = number;
+        result.PowMod( exponent, modulus );
+        ASSERT_EQ( result, SlowPowMod( number, exponent, modulus ) );
+    }
+}
+
+TEST_F( PowModUnittests, pow_mod_should_satisfy_fermats_little_theorem )
+{
+    const SimpleBigNum prime = GetMersennePrime();
+    SimpleBigNum exponent = prime;
+    exponent -= 1;
+
+    for( uint32_t i = 0; i < 20; ++i )
+    {
+        SimpleBigNum number = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 64 ) + 1 );
+        number.PowMod( exponent, prime );
+        ASSERT_EQ( number, 1 );
+    }
+}
+
+TEST_F( PowModUnittests, pow_mod_of_sum_of_exponents_should_be_product_of_pow_mods )
+{
+    for( uint32_t i = 0; i < 10; ++i )
+    {
+        // Long moduli use Barrett reduction with reciprocal.
+        SimpleBigNum modulus = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 1000 ) + 1 );
+        if( i % 2 == 0 )
+            modulus *= 2;
+
+        const SimpleBigNum number = GetNextRandomBigNum( modulus.GetNumberOfDigits() );
+        const SimpleBigNum exponent1 = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 64 ) + 1 );
+        const SimpleBigNum exponent2 = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 64 ) + 1 );
+
+        SimpleBigNum result = number;
+        SimpleBigNum exponentSum = exponent1;
+        exponentSum += exponent2;
+        result.PowMod( exponentSum, modulus );
+
+        SimpleBigNum wantedResult = number;
+        wantedResult.PowMod( exponent1, modulus );
+        SimpleBigNum secondPower = number;
+        secondPower.PowMod( exponent2, modulus );
+        wantedResult *= secondPower;
+        wantedResult %= modulus;
+        ASSERT_EQ( result, wantedResult );
+    }
+}
+
+TEST_F( PowModUnittests, fixed_base_exponentiator_should_match_pow_mod )
+{
+    for( uint32_t i = 0; i < 20; ++i )
+    {
+        SimpleBigNum modulus = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 100 ) + 1 );
+        if( i % 2 == 0 )
+            modulus *= 2;
+
+        const SimpleBigNum base = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 150 ) + 1 );
+        const uint32_t maxExponentBits = ( uint32_t )( GetNextRandomNumber() % 600 ) + 1;
+        const FixedBaseExponentiator exponentiator( base, modulus, maxExponentBits );
+        ASSERT_EQ( exponentiator.GetModulus(), modulus );
+
+        for( uint32_t j = 0; j < 10; ++j )
+        {
+            // Every third exponent is too long for the precomputed table.
+            const uint32_t exponentBits = j % 3 == 0 ? maxExponentBits + 8 : maxExponentBits;
+            SimpleBigNum exponent = GetNextRandomBigNum( ( exponentBits + 7 ) / 8 );
+            while( exponent.GetNumberOfDigits() * 8 > exponentBits )
+                exponent /= 2;
+
+            SimpleBigNum result;
+            exponentiator.PowMod( exponent, result );
+            SimpleBigNum wantedResult = base;
+            wantedResult.PowMod( exponent, modulus );
+            ASSERT_EQ( result, wantedResult );
+        }
+    }
+}
+
+TEST_F( PowModUnittests, fixed_base_exponentiator_trivial_cases )
+{
+    const FixedBaseExponentiator exponentiator( 3, 7, 64 );
+    SimpleBigNum result;
+    exponentiator.PowMod( 0, result );
+    ASSERT_EQ( result, 1 );
+    exponentiator.PowMod( 5, result );
+    ASSERT_EQ( result, 5 );
+
+    const FixedBaseExponentiator zeroModulusExponentiator( 3, 0, 64 );
+    zeroModulusExponentiator.PowMod( 5, result );
+    ASSERT_EQ( result, 0 );
+
+    const FixedBaseExponentiator zeroBaseExponentiator( 0, 7, 64 );
+    zeroBaseExponentiator.PowMod( 5, result );
+    ASSERT_EQ( result, 0 );
+}
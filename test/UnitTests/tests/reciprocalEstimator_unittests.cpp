@@ -4,23 +4,54 @@
 using namespace sbn;
 using namespace sbn::internal;
 
-static void PerformTest( const SimpleBigNum& number, uint32_t shift, uint32_t steps, const std::string& wantedAnswer )
+static void PerformTest( const SimpleBigNum& number, uint32_t shift, const std::string& wantedAnswer )
 {
-    SimpleBigNum reciprocal = ReciprocalEstimator::Estimate( number, shift, steps );
+    SimpleBigNum reciprocal = ReciprocalEstimator::Estimate( number, shift );
     ASSERT_EQ( reciprocal.ToString(), wantedAnswer );
 }
 
 TEST( ReciprocalEstimatorUnittests, reciprocal_of_2 )
 {
-    PerformTest( SimpleBigNum( 2 ), 4, 15, "2147483648" );
+    PerformTest( SimpleBigNum( 2 ), 4, "2147483648" );
 }
 
 TEST( ReciprocalEstimatorUnittests, reciprocal_of_1256 )
 {
-    PerformTest( SimpleBigNum( 1256 ), 8, 15, "14686898147857924" );
+    PerformTest( SimpleBigNum( 1256 ), 8, "14686898147857923" );
 }
 
 TEST( ReciprocalEstimatorUnittests, reciprocal_of_6548625354375474 )
 {
-    PerformTest( SimpleBigNum( 6548625354375474 ), 10, 15, "184607571" );
-}
\ No newline at end of file
+    PerformTest( SimpleBigNum( 6548625354375474 ), 10, "184607570" );
+}
+
+TEST( ReciprocalEstimatorUnittests, reciprocal_of_power_of_two )
+{
+    // 256^20 / 256^3
+    PerformTest( SimpleBigNum( 0x1000000 ), 20, "87112285931760246646623899502532662132736" );
+}
+
+TEST( ReciprocalEstimatorUnittests, reciprocal_of_number_bigger_then_power_should_be_zero )
+{
+    PerformTest( SimpleBigNum( 0xFFFFFFFFFFFFFFFF ), 7, "0" );
+}
+
+class ReciprocalEstimatorRandomUnittests : public BaseTestWithRandomBigNums
+{
+};
+
+TEST_F( ReciprocalEstimatorRandomUnittests, estimate_should_match_long_division )
+{
+    for( uint32_t i = 0; i < 300; ++i )
+    {
+        const uint32_t numberOfDigits = ( uint32_t )( GetNextRandomNumber() % 1500 + 1 );
+        const SimpleBigNum number = GetNextRandomBigNum( numberOfDigits );
+        const uint32_t shift = numberOfDigits + ( uint32_t )( GetNextRandomNumber() % 2000 );
+
+        SimpleBigNum wantedReciprocal( 1 );
+        wantedReciprocal << shift;
+        wantedReciprocal /= number;
+
+        ASSERT_EQ( ReciprocalEstimator::Estimate( number, shift ), wantedReciprocal );
+    }
+}
@@ -0,0 +1,127 @@
+#include "pch.h"
+
+using namespace sbn;
+
+class RootUnittests : public BaseTestWithRandomBigNums
+{
+public:
+    // Checks, that root^n <= number < ( root + 1 )^n.
+    static void CheckRoot( const SimpleBigNum& number, const SimpleBigNum& root, uint32_t n )
+    {
+        SimpleBigNum power = root;
+        power.Pow( n );
+        ASSERT_TRUE( power <= number );
+
+        SimpleBigNum nextPower = root;
+        nextPower += 1;
+        nextPower.Pow( n );
+        ASSERT_TRUE( nextPower > number );
+    }
+};
+
+TEST_F( RootUnittests, trivial_cases )
+{
+    for( uint64_t value : { 0ull, 1ull, 2ull, 3ull, 4ull, 15ull, 16ull, 17ull, 0xFFFFFFFFFFFFFFFFull } )
+    {
+        SimpleBigNum number = value;
+        number.Sqrt();
+        CheckRoot( value, number, 2 );
+    }
+
+    SimpleBigNum number = 12345;
+    number.Root( 0 );
+    ASSERT_EQ( number, 0 );
+
+    number = 12345;
+    number.Root( 1 );
+    ASSERT_EQ( number, 12345 );
+
+    number = 7;
+    number.Root( 3 );
+    ASSERT_EQ( number, 1 );
+
+    number = 27;
+    number.Root( 3 );
+    ASSERT_EQ( number, 3 );
+
+    number = 1;
+    number.ShitfLeft( 100 );
+    number.Root( 1000 );
+    ASSERT_EQ( number, 1 );
+}
+
+TEST_F( RootUnittests, sqrt_of_random_numbers )
+{
+    for( uint32_t i = 0; i < 300; ++i )
+    {
+        const SimpleBigNum number = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % ( i % 10 == 0 ? 5000 : 300 ) ) + 1 );
+        SimpleBigNum root = number;
+        root.Sqrt();
+        CheckRoot( number, root, 2 );
+    }
+}
+
+TEST_F( RootUnittests, sqrt_of_squares_and_neighbours )
+{
+    for( uint32_t i = 0; i < 100; ++i )
+    {
+        const SimpleBigNum root = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 300 ) + 1 );
+        SimpleBigNum square = root;
+        square.Square();
+
+        SimpleBigNum result = square;
+        SimpleBigNum remainder;
+        result.SqrtRem( remainder );
+        ASSERT_EQ( result, root );
+        ASSERT_TRUE( remainder.IsZero() );
+
+        // ( root + 1 )^2 - 1 = root^2 + 2 * root has the biggest remainder.
+        SimpleBigNum wantedRemainder = root;
+        wantedRemainder *= 2;
+        result = square;
+        result += wantedRemainder;
+        result.SqrtRem( remainder );
+        ASSERT_EQ( result, root );
+        ASSERT_EQ( remainder, wantedRemainder );
+
+        result = square;
+        result -= 1;
+        result.Sqrt();
+        SimpleBigNum wantedResult = root;
+        wantedResult -= 1;
+        ASSERT_EQ( result, wantedResult );
+    }
+}
+
+TEST_F( RootUnittests, root_of_random_numbers )
+{
+    for( uint32_t i = 0; i < 300; ++i )
+    {
+        const uint32_t n = ( uint32_t )( GetNextRandomNumber() % 20 ) + 3;
+        const SimpleBigNum number = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 500 ) + 1 );
+        SimpleBigNum root = number;
+        root.Root( n );
+        CheckRoot( number, root, n );
+    }
+}
+
+TEST_F( RootUnittests, root_of_exact_powers )
+{
+    for( uint32_t i = 0; i < 100; ++i )
+    {
+        const uint32_t n = ( uint32_t )( GetNextRandomNumber() % 10 ) + 2;
+        const SimpleBigNum root = GetNextRandomBigNum( ( uint32_t )( GetNextRandomNumber() % 100 ) + 1 );
+        SimpleBigNum power = root;
+        power.Pow( n );
+
+        SimpleBigNum result = power;
+        result.Root( n );
+        ASSERT_EQ( result, root );
+
+        power -= 1;
+        power.Root( n );
+        SimpleBigNum wantedResult = root;
+        wantedResult -= 1;
+        ASSERT_EQ( power, wantedResult );
+    }
+}
@@ -16,6 +16,18 @@ TEST_F( SubtructionUnittests, simple_subtruction_with_carry )
     ASSERT_EQ( bigNumber.ToString(), std::to_string( 65535 ) );
 }
 
+TEST_F( SubtructionUnittests, subtruction_with_borrow_across_limbs )
+{
+    SimpleBigNum::TRawNumberDigits digits( 100, 0 );
+    digits.push_back( 1 );
+    SimpleBigNum bigNumber( digits.begin(), digits.end() );
+    bigNumber -= 1;
+
+    const SimpleBigNum::TRawNumberDigits wantedDigits( 100, 255 );
+    ASSERT_EQ( bigNumber, SimpleBigNum( wantedDigits.begin(), wantedDigits.end() ) );
+    ASSERT_EQ( bigNumber.GetNumberOfDigits(), 100 );
+}
+
 TEST_F( SubtructionUnittests, simple_subtruction_with_zero )
 {
     const uint64_t num = GetNextRandomNumber();
@@ -77,4 +89,20 @@ TEST_F( SubtructionUnittests, subtracting_bigger_from_smaller_should_give_zero )
 
         ASSERT_EQ( number.ToString(), "0" );
     }
-}
\ No newline at end of file
+}
+
+TEST_F( SubtructionUnittests, scalar_subtruction_with_borrow_across_limbs )
+{
+    SimpleBigNum::TRawNumberDigits digits = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+    SimpleBigNum bigNumber( digits.begin(), digits.end() );
+
+    bigNumber -= 1;
+    ASSERT_EQ( bigNumber.ToString(), "340282366920938463463374607431768211455" );
+    ASSERT_EQ( bigNumber.GetNumberOfDigits(), 16 );
+
+    bigNumber -= bigNumber;
+    ASSERT_TRUE( bigNumber.IsZero() );
+
+    bigNumber -= 5;
+    ASSERT_TRUE( bigNumber.IsZero() );
+}
@@ -31,4 +31,172 @@ TEST_F( ToFromStringUnittests, from_string_stochastic_test )
 
         ASSERT_EQ( bigNumber.ToString(), wantedString );
     }
-}
\ No newline at end of file
+}
+
+TEST_F( ToFromStringUnittests, to_string_with_separators )
+{
+    ASSERT_EQ( SimpleBigNum( 0 ).ToString( true ), "0" );
+    ASSERT_EQ( SimpleBigNum( 123 ).ToString( true ), "123" );
+    ASSERT_EQ( SimpleBigNum( 1234 ).ToString( true ), "1,234" );
+    ASSERT_EQ( SimpleBigNum( 123456 ).ToString( true ), "123,456" );
+    ASSERT_EQ( SimpleBigNum( 18446744073709551615ull ).ToString( true ), "18,446,744,073,709,551,615" );
+}
+
+TEST_F( ToFromStringUnittests, to_string_powers_of_ten )
+{
+    // Powers around multiples of 19 digits and their doublings hit borders of the chunks.
+    for( uint32_t exponent : { 1u, 18u, 19u, 20u, 37u, 38u, 39u, 76u, 151u, 152u, 153u, 760u, 761u, 1216u, 2431u, 2432u, 9728u, 50000u } )
+    {
+        SimpleBigNum power = 10;
+        power.Pow( exponent );
+        ASSERT_EQ( power.ToString(), "1" + std::string( exponent, '0' ) );
+
+        power.Subtruct( 1 );
+        ASSERT_EQ( power.ToString(), std::string( exponent, '9' ) );
+    }
+}
+
+TEST_F( ToFromStringUnittests, to_string_long_numbers )
+{
+    for( uint32_t i = 0; i < 40; ++i )
+    {
+        SimpleBigNum::TRawNumberDigits digits( ( uint32_t )( GetNextRandomNumber() % 3000 ) + 1 );
+        for( auto& digit : digits )
+            digit = ( uint8_t )GetNextRandomNumber();
+
+        const SimpleBigNum number( digits.begin(), digits.end() );
+        const std::string numberString = number.ToString();
+        ASSERT_TRUE( numberString.size() == 1 || numberString[ 0 ] != '0' );
+
+        SimpleBigNum parsed;
+        parsed.FromString( numberString );
+        ASSERT_EQ( parsed, number );
+    }
+}
+
+TEST_F( ToFromStringUnittests, from_string_invalid_input )
+{
+    SimpleBigNum number = 123;
+    ASSERT_FALSE( number.FromString( "" ) );
+    ASSERT_TRUE( number.IsZero() );
+
+    for( const char* invalidString : { "12a3", "-123", "+1", "1 000", "1,000", "12345678901234567890123456789x" } )
+    {
+        number = 123;
+        ASSERT_FALSE( number.FromString( invalidString ) );
+        ASSERT_TRUE( number.IsZero() );
+    }
+
+    ASSERT_TRUE( number.FromString( "000000000000000000000000000000000000000012" ) );
+    ASSERT_EQ( number, 12 );
+}
+
+TEST_F( ToFromStringUnittests, from_string_powers_of_ten )
+{
+    for( uint32_t exponent : { 0u, 18u, 19u, 20u, 759u, 760u, 761u, 1519u, 1520u, 1521u, 50000u } )
+    {
+        SimpleBigNum power = 10;
+        power.Pow( exponent );
+
+        SimpleBigNum parsed;
+        ASSERT_TRUE( parsed.FromString( "1" + std::string( exponent, '0' ) ) );
+        ASSERT_EQ( parsed, power );
+
+        power.Subtruct( 1 );
+        ASSERT_TRUE( parsed.FromString( std::string( exponent, '9' ) + ( exponent == 0 ? "0" : "" ) ) );
+        ASSERT_EQ( parsed, power );
+    }
+}
+
+TEST_F( ToFromStringUnittests, from_string_long_numbers )
+{
+    for( uint32_t i = 0; i < 20; ++i )
+    {
+        std::string numberString( ( size_t )( GetNextRandomNumber() % 100000 ) + 1, '0' );
+        for( auto& digit : numberString )
+            digit = ( char )( '0' + GetNextRandomNumber() % 10 );
+        numberString[ 0 ] = ( char )( '1' + GetNextRandomNumber() % 9 );
+
+        SimpleBigNum number;
+        ASSERT_TRUE( number.FromString( numberString ) );
+        ASSERT_EQ( number.ToString(), numberString );
+    }
+}
+
+TEST_F( ToFromStringUnittests, hex_string_known_values )
+{
+    ASSERT_EQ( SimpleBigNum( 0 ).ToHexString(), "0" );
+    ASSERT_EQ( SimpleBigNum( 255 ).ToHexString(), "ff" );
+    ASSERT_EQ( SimpleBigNum( 0x123456789abcdef0 ).ToHexString(), "123456789abcdef0" );
+
+    SimpleBigNum number = 1;
+    number.ShitfLeft( 8 );
+    ASSERT_EQ( number.ToHexString(), "10000000000000000" );
+
+    ASSERT_TRUE( number.FromHexString( "DeadBeef" ) );
+    ASSERT_EQ( number, 0xdeadbeef );
+    ASSERT_TRUE( number.FromHexString( "00000000000000000000000000000000000000ff" ) );
+    ASSERT_EQ( number, 255 );
+    ASSERT_TRUE( number.FromHexString( "0" ) );
+    ASSERT_TRUE( number.IsZero() );
+}
+
+TEST_F( ToFromStringUnittests, power_of_two_base_string_stochastic_test )
+{
+    const char* digitCharacters = "0123456789abcdefghijklmnopqrstuv";
+    for( uint32_t base : { 2, 4, 8, 16, 32 } )
+    {
+        for( uint32_t i = 0; i < 100; ++i )
+        {
+            std::string numberString( ( size_t )( GetNextRandomNumber() % 1000 ) + 1, '0' );
+            for( auto& digit : numberString )
+                digit = digitCharacters[ GetNextRandomNumber() % base ];
+            numberString[ 0 ] = digitCharacters[ 1 + GetNextRandomNumber() % ( base - 1 ) ];
+
+            // Reference value is computed by Horner's scheme.
+            SimpleBigNum expected;
+            for( char digit : numberString )
+            {
+                expected *= SimpleBigNum( base );
+                expected += SimpleBigNum( ( uint64_t )( strchr( digitCharacters, digit ) - digitCharacters ) );
+            }
+
+            SimpleBigNum number;
+            ASSERT_TRUE( number.FromPowerOfTwoBaseString( numberString, base ) );
+            ASSERT_EQ( number, expected );
+            ASSERT_EQ( number.ToPowerOfTwoBaseString( base ), numberString );
+        }
+    }
+}
+
+TEST_F( ToFromStringUnittests, power_of_two_base_string_invalid_input )
+{
+    SimpleBigNum number = 123;
+    ASSERT_FALSE( number.FromHexString( "" ) );
+    ASSERT_TRUE( number.IsZero() );
+
+    for( const char* invalidString : { "12g3", "-ff", "0x10", "ff ff", "123456789abcdef0123456789abcdef0z" } )
+    {
+        number = 123;
+        ASSERT_FALSE( number.FromHexString( invalidString ) );
+        ASSERT_TRUE( number.IsZero() );
+    }
+
+    number = 123;
+    ASSERT_FALSE( number.FromPowerOfTwoBaseString( "102", 2 ) );
+    ASSERT_TRUE( number.IsZero() );
+    number = 123;
+    ASSERT_FALSE( number.FromPowerOfTwoBaseString( "1237778", 8 ) );
+    ASSERT_TRUE( number.IsZero() );
+    number = 123;
+    ASSERT_FALSE( number.FromPowerOfTwoBaseString( "vvw", 32 ) );
+    ASSERT_TRUE( number.IsZero() );
+
+    for( uint32_t base : { 0, 1, 3, 10, 64 } )
+    {
+        number = 123;
+        ASSERT_FALSE( number.FromPowerOfTwoBaseString( "1", base ) );
+        ASSERT_TRUE( number.IsZero() );
+        ASSERT_TRUE( SimpleBigNum( 123 ).ToPowerOfTwoBaseString( base ).empty() );
+    }
+}